@@ -0,0 +1,97 @@
+// Micro-benchmarks for the board kernels: scalar BoardKernel<N> against the
+// packed SIMD versions. Build with optimisations and the target ISA, e.g.
+//   g++ -std=c++14 -O2 -mavx2 boardBench.cpp boardKernels.cpp packedBoard.cpp -o boardBench
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <chrono>
+#include <vector>
+#include "boardKernels.h"
+#include "packedBoard.h"
+
+const int BOARD_COUNT = 4096;
+const int ROUNDS = 2000;
+
+struct Boards {
+    std::vector<unsigned char> cells;
+    int size;
+
+    const unsigned char* at(const int i) const { return &cells[i * BOARD_MAX_CELLS]; }
+};
+
+static Boards makeBoards(const int size) {
+    Boards boards = {std::vector<unsigned char>(BOARD_COUNT * BOARD_MAX_CELLS, 0), size};
+
+    for (int b = 0; b < BOARD_COUNT; ++b) {
+        unsigned char* cells = &boards.cells[b * BOARD_MAX_CELLS];
+        for (int i = 0; i < size * size; ++i) {
+            cells[i] = i + 1;
+        }
+
+        // A quarter of the boards stay solved so both outcomes are exercised.
+        int blank = size * size - 1;
+        const int walk = (b % 4 == 0) ? 0 : 200;
+        for (int step = 0; step < walk; ++step) {
+            int moves[4];
+            const int count = generateMovesGeneric(blank, moves, size);
+            const int next = moves[rand() % count];
+            cells[blank] = cells[next];
+            cells[next] = size * size;
+            blank = next;
+        }
+    }
+    return boards;
+}
+
+template <typename Func>
+static void bench(const char* name, const Boards& boards, Func func) {
+    long long checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < ROUNDS; ++round) {
+        for (int b = 0; b < BOARD_COUNT; ++b) {
+            checksum += func(boards.at(b), boards.size);
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+    printf("%-28s %7.2f ns/board  (checksum %lld)\n", name, nanoseconds / (double(ROUNDS) * BOARD_COUNT), checksum);
+}
+
+static bool verify(const Boards& boards, const BoardOps& scalar, const BoardOps& packed) {
+    for (int b = 0; b < BOARD_COUNT; ++b) {
+        const unsigned char* cells = boards.at(b);
+        if (scalar.isSolved(cells, boards.size) != packed.isSolved(cells, boards.size) ||
+            scalar.manhattan(cells, boards.size) != packed.manhattan(cells, boards.size)) {
+            printf("Mismatch between scalar and packed kernels on %dx%d board %d!\n", boards.size, boards.size, b);
+            return false;
+        }
+    }
+    return true;
+}
+
+template <int N>
+static void benchSize(const BoardOps& packed) {
+    const Boards boards = makeBoards(N);
+    const BoardOps scalar = {N, BoardKernel<N>::isSolved, BoardKernel<N>::manhattan, BoardKernel<N>::generateMoves, hashPacked};
+
+    printf("%dx%d\n", N, N);
+    if (!verify(boards, scalar, packed)) {
+        exit(1);
+    }
+    bench("  isSolved (generic)", boards, isSolvedGeneric);
+    bench("  isSolved (scalar)", boards, scalar.isSolved);
+    bench("  isSolved (packed)", boards, packed.isSolved);
+    bench("  manhattan (generic)", boards, manhattanGeneric);
+    bench("  manhattan (scalar)", boards, scalar.manhattan);
+    bench("  manhattan (packed)", boards, packed.manhattan);
+    bench("  hash (packed)", boards, [](const unsigned char* cells, const int size) {
+        return (long long)(hashPacked(cells, size) & 0xFFFF);
+    });
+}
+
+int main() {
+    srand(1);
+    benchSize<4>(getBoardOps(4));
+    benchSize<5>(getBoardOps(5));
+    return 0;
+}
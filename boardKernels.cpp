@@ -0,0 +1,80 @@
+#include "boardKernels.h"
+#include "packedBoard.h"
+#include <stdlib.h>
+
+bool isSolvedGeneric(const unsigned char* cells, const int size) {
+    for (int i = 0; i < size * size - 1; ++i) {
+        if (cells[i] != i + 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int manhattanGeneric(const unsigned char* cells, const int size) {
+    int distance = 0;
+    for (int i = 0; i < size * size; ++i) {
+        const int number = cells[i];
+        if (number != size * size) {
+            distance += abs(i / size - (number - 1) / size) + abs(i % size - (number - 1) % size);
+        }
+    }
+    return distance;
+}
+
+int generateMovesGeneric(const int blank, int* moves, const int size) {
+    const int row = blank / size;
+    const int col = blank % size;
+
+    int count = 0;
+    if (row > 0) {
+        moves[count++] = blank - size;
+    }
+    if (col < size - 1) {
+        moves[count++] = blank + 1;
+    }
+    if (row < size - 1) {
+        moves[count++] = blank + size;
+    }
+    if (col > 0) {
+        moves[count++] = blank - 1;
+    }
+    return count;
+}
+
+template <int N>
+static BoardOps makeBoardOps() {
+    return {N, BoardKernel<N>::isSolved, BoardKernel<N>::manhattan, BoardKernel<N>::generateMoves, hashPacked};
+}
+
+BoardOps getBoardOps(const unsigned int size) {
+    switch (size) {
+        case 3:
+            return makeBoardOps<3>();
+        case 4:
+            return {4, isSolvedPacked4, manhattanPacked4, BoardKernel<4>::generateMoves, hashPacked};
+        case 5:
+            return {5, isSolvedPacked5, manhattanPacked5, BoardKernel<5>::generateMoves, hashPacked};
+        default:
+            return {size, isSolvedGeneric, manhattanGeneric, generateMovesGeneric, hashPacked};
+    }
+}
+
+int scrambleBoard(const BoardOps& ops, unsigned char* cells, const unsigned int seed, const unsigned int swaps) {
+    const int size = ops.size;
+    for (int i = 0; i < size * size; ++i) {
+        cells[i] = i + 1;
+    }
+
+    srand(seed);
+    int blank = size * size - 1;
+    int moves[4];
+    for (unsigned int swap = 0; swap < swaps; ++swap) {
+        const int count = ops.generateMoves(blank, moves, size);
+        const int next = moves[rand() % count];
+        cells[blank] = cells[next];
+        cells[next] = size * size;
+        blank = next;
+    }
+    return blank;
+}
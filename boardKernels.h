@@ -0,0 +1,105 @@
+#pragma once
+#include <stdint.h>
+
+const int BOARD_MAX_SIZE = 10;
+const int BOARD_MAX_CELLS = BOARD_MAX_SIZE * BOARD_MAX_SIZE;
+
+// Boards are stored row by row as tile numbers 1..N*N, the blank being N*N.
+// The kernels below are specialised for the sizes offered in the menu, with a
+// runtime-sized fallback for everything else. Cells arrays are
+// BOARD_MAX_CELLS long with the unused tail zeroed.
+struct BoardOps {
+    unsigned int size;
+    bool (*isSolved)(const unsigned char* cells, const int size);
+    int (*manhattan)(const unsigned char* cells, const int size);
+    int (*generateMoves)(const int blank, int* moves, const int size);
+    uint64_t (*hash)(const unsigned char* cells, const int size);
+};
+
+template <int N>
+struct BoardTables {
+    int neighbourCount[N * N];
+    int neighbours[N * N][4];
+    unsigned char distance[N * N][N * N + 1];
+};
+
+template <int N>
+constexpr BoardTables<N> makeBoardTables() {
+    BoardTables<N> tables = {};
+    for (int cell = 0; cell < N * N; ++cell) {
+        const int row = cell / N;
+        const int col = cell % N;
+
+        int count = 0;
+        if (row > 0) {
+            tables.neighbours[cell][count++] = cell - N;
+        }
+        if (col < N - 1) {
+            tables.neighbours[cell][count++] = cell + 1;
+        }
+        if (row < N - 1) {
+            tables.neighbours[cell][count++] = cell + N;
+        }
+        if (col > 0) {
+            tables.neighbours[cell][count++] = cell - 1;
+        }
+        tables.neighbourCount[cell] = count;
+
+        for (int number = 1; number < N * N; ++number) {
+            const int goalRow = (number - 1) / N;
+            const int goalCol = (number - 1) % N;
+            const int rowDistance = (row > goalRow) ? row - goalRow : goalRow - row;
+            const int colDistance = (col > goalCol) ? col - goalCol : goalCol - col;
+            tables.distance[cell][number] = rowDistance + colDistance;
+        }
+        tables.distance[cell][N * N] = 0;
+    }
+    return tables;
+}
+
+template <int N>
+struct BoardKernel {
+    static constexpr BoardTables<N> TABLES = makeBoardTables<N>();
+
+    static bool isSolved(const unsigned char* cells, const int) {
+        int mismatch = 0;
+        for (int i = 0; i < N * N - 1; ++i) {
+            mismatch |= cells[i] ^ (i + 1);
+        }
+        return mismatch == 0;
+    }
+
+    static int manhattan(const unsigned char* cells, const int) {
+        int distance = 0;
+        for (int i = 0; i < N * N; ++i) {
+            distance += TABLES.distance[i][cells[i]];
+        }
+        return distance;
+    }
+
+    static int generateMoves(const int blank, int* moves, const int) {
+        const int count = TABLES.neighbourCount[blank];
+        for (int i = 0; i < 4; ++i) {
+            moves[i] = TABLES.neighbours[blank][i];
+        }
+        return count;
+    }
+};
+
+// TABLES is indexed at runtime, so before C++17, where static constexpr
+// members became implicitly inline, it needs a definition. The kernels rely
+// on C++14 loops in constexpr functions.
+#if __cplusplus < 201703L
+template <int N>
+constexpr BoardTables<N> BoardKernel<N>::TABLES;
+#endif
+
+bool isSolvedGeneric(const unsigned char* cells, const int size);
+int manhattanGeneric(const unsigned char* cells, const int size);
+int generateMovesGeneric(const int blank, int* moves, const int size);
+
+BoardOps getBoardOps(const unsigned int size);
+
+// Random walk of the blank from the solved board, seeded through srand() so a
+// seed always reproduces the same board. Returns the blank's final cell.
+int scrambleBoard(const BoardOps& ops, unsigned char* cells, const unsigned int seed, const unsigned int swaps);
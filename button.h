@@ -5,7 +5,7 @@
 
 class Button : public UserInterface {
     public:
-        Button(const SDL_Rect& rect, const SDL_Color& colour, TTF_Font* const font, const SDL_Color& fontColour);
+        Button(const SDL_Rect& rect, const SDL_Color& colour, const int fontSize, const SDL_Color& fontColour);
         
         bool isMouseInside(const int x, const int y) const;
         void changeColourTo(const SDL_Colour& colour);
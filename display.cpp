@@ -0,0 +1,271 @@
+#include "display.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "logger.h"
+#include "textureCache.h"
+
+void printDisplayUsage() {
+    fprintf(stderr,
+        "  --software          use the software renderer\n"
+        "  --accelerated       use a hardware accelerated renderer (default)\n"
+        "  --vsync             wait for vertical sync on present (default)\n"
+        "  --no-vsync          present immediately, paced by --fps\n"
+        "  --fps N             frame cap without vsync, 0 to 1000 with 0 for uncapped\n"
+        "                      (default 60)\n"
+        "  --scale S           initial window size relative to the default (default 1)\n"
+        "  --render-to-texture draw into an offscreen target and scale it on present\n"
+        "  --linear            filter the scaled frame linearly instead of nearest\n");
+}
+
+void setDefaultDisplayOptions(DisplayOptions& options) {
+    options = {BACKEND_ACCELERATED, true, 60, false, 1.0f, false};
+}
+
+bool parseDisplayOption(int argc, char* args[], int& i, DisplayOptions& options) {
+    const bool hasValue = i + 1 < argc;
+    if (strcmp(args[i], "--software") == 0) {
+        options.backend = BACKEND_SOFTWARE;
+    } else if (strcmp(args[i], "--accelerated") == 0) {
+        options.backend = BACKEND_ACCELERATED;
+    } else if (strcmp(args[i], "--vsync") == 0) {
+        options.vsync = true;
+    } else if (strcmp(args[i], "--no-vsync") == 0) {
+        options.vsync = false;
+    } else if (strcmp(args[i], "--fps") == 0 && hasValue) {
+        const int frameCap = atoi(args[++i]);
+        if (frameCap < 0 || frameCap > 1000) {
+            return false;
+        }
+        options.frameCap = frameCap;
+    } else if (strcmp(args[i], "--scale") == 0 && hasValue) {
+        const float scale = atof(args[++i]);
+        if (scale < 0.25f || scale > 8.0f) {
+            return false;
+        }
+        options.scale = scale;
+    } else if (strcmp(args[i], "--render-to-texture") == 0) {
+        options.renderToTexture = true;
+    } else if (strcmp(args[i], "--linear") == 0) {
+        options.linearFiltering = true;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+Display::Display(const DisplayOptions& options)
+    : mOptions(options), mWindow(nullptr), mRenderer(nullptr), mTarget(nullptr),
+      mWidth(0), mHeight(0), mPixelRatioX(1), mPixelRatioY(1),
+      mLastFrameTicks(0), mLastPresent(0), mStartTime(0), mHasPendingInput(false), mPendingInput(0), mPendingSequence(0),
+      mStats(), mDescription("") {
+
+}
+
+Display::~Display() {
+    close();
+}
+
+bool Display::open(SDL_Window* window) {
+    mWindow = window;
+
+    Uint32 flags = mOptions.backend == BACKEND_SOFTWARE ? SDL_RENDERER_SOFTWARE : SDL_RENDERER_ACCELERATED;
+    if (mOptions.vsync) {
+        flags |= SDL_RENDERER_PRESENTVSYNC;
+    }
+    if (mOptions.renderToTexture) {
+        flags |= SDL_RENDERER_TARGETTEXTURE;
+    }
+
+    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, mOptions.linearFiltering ? "linear" : "nearest");
+
+    mRenderer = SDL_CreateRenderer(window, -1, flags);
+    if (mRenderer == nullptr) {
+        LOG_ERROR("SDL could not create renderer! Error: %s", SDL_GetError());
+        return false;
+    }
+
+    SDL_GetRendererOutputSize(mRenderer, &mWidth, &mHeight);
+    updatePixelRatio();
+
+    if (mOptions.renderToTexture) {
+        mTarget = SDL_CreateTexture(mRenderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, mWidth, mHeight);
+        if (mTarget == nullptr) {
+            LOG_WARNING("Failed to create render target, drawing directly! Error: %s", SDL_GetError());
+        } else {
+            // The logical size makes SDL scale the target onto the window
+            // and map mouse events back into target pixels.
+            SDL_RenderSetLogicalSize(mRenderer, mWidth, mHeight);
+        }
+    }
+
+    SDL_RendererInfo info;
+    const char* name = SDL_GetRendererInfo(mRenderer, &info) == 0 ? info.name : "unknown";
+    snprintf(mDescription, sizeof(mDescription), "%s, %s, %s, scale %.2f",
+        name,
+        mOptions.vsync ? "vsync" : "no vsync",
+        mTarget ? "render to texture" : "direct",
+        mOptions.scale);
+
+    mLastFrameTicks = SDL_GetTicks();
+    return true;
+}
+
+void Display::close() {
+    // Cached text textures die with the renderer, so drop them first; any
+    // still referenced would be left dangling.
+    gTextureCache.clear();
+    if (gTextureCache.size() != 0) {
+        LOG_WARNING("%zu textures still alive when closing the display!", gTextureCache.size());
+    }
+
+    if (mTarget) {
+        SDL_DestroyTexture(mTarget);
+        mTarget = nullptr;
+    }
+    if (mRenderer) {
+        SDL_DestroyRenderer(mRenderer);
+        mRenderer = nullptr;
+    }
+}
+
+SDL_Renderer* Display::getRenderer() const {
+    return mRenderer;
+}
+
+int Display::getWidth() const {
+    return mWidth;
+}
+
+int Display::getHeight() const {
+    return mHeight;
+}
+
+void Display::updatePixelRatio() {
+    int windowWidth, windowHeight;
+    SDL_GetWindowSize(mWindow, &windowWidth, &windowHeight);
+    int outputWidth, outputHeight;
+    SDL_GetRendererOutputSize(mRenderer, &outputWidth, &outputHeight);
+    if (windowWidth > 0 && windowHeight > 0) {
+        mPixelRatioX = (float)outputWidth / windowWidth;
+        mPixelRatioY = (float)outputHeight / windowHeight;
+    }
+}
+
+bool Display::handleEvent(const SDL_Event& event) {
+    if (event.type != SDL_WINDOWEVENT || event.window.event != SDL_WINDOWEVENT_SIZE_CHANGED || mRenderer == nullptr) {
+        return false;
+    }
+
+    updatePixelRatio();
+    if (mTarget) {
+        return false;
+    }
+
+    int width, height;
+    SDL_GetRendererOutputSize(mRenderer, &width, &height);
+    if (width == mWidth && height == mHeight) {
+        return false;
+    }
+    mWidth = width;
+    mHeight = height;
+    return true;
+}
+
+void Display::toLayout(int& x, int& y) const {
+    if (mTarget == nullptr) {
+        x *= mPixelRatioX;
+        y *= mPixelRatioY;
+    }
+}
+
+bool Display::beginFrame() {
+    if (!mOptions.vsync && mOptions.frameCap != 0) {
+        const Uint32 milliSecondsPerFrame = 1000 / mOptions.frameCap;
+        const Uint32 deltaTimeRendered = SDL_GetTicks() - mLastFrameTicks;
+        if (deltaTimeRendered < milliSecondsPerFrame) {
+            SDL_Delay(milliSecondsPerFrame - deltaTimeRendered);
+            return false;
+        }
+    }
+    mLastFrameTicks = SDL_GetTicks();
+
+    if (mTarget) {
+        SDL_SetRenderTarget(mRenderer, mTarget);
+    }
+    return true;
+}
+
+void Display::present(const unsigned int inputsShown) {
+    if (mTarget) {
+        SDL_SetRenderTarget(mRenderer, nullptr);
+        SDL_SetRenderDrawColor(mRenderer, 0, 0, 0, 255);
+        SDL_RenderClear(mRenderer);
+        SDL_RenderCopy(mRenderer, mTarget, nullptr, nullptr);
+    }
+    SDL_RenderPresent(mRenderer);
+    recordFrame(SDL_GetPerformanceCounter(), inputsShown);
+}
+
+void Display::markInput(const Uint32 timestamp, const unsigned int sequence) {
+    if (!mHasPendingInput) {
+        mHasPendingInput = true;
+        mPendingInput = timestamp;
+        mPendingSequence = sequence;
+    }
+}
+
+void Display::recordFrame(const Uint64 now, const unsigned int inputsShown) {
+    if (mHasPendingInput && inputsShown >= mPendingSequence) {
+        const double latency = SDL_GetTicks() - mPendingInput;
+        mStats.inputs++;
+        mStats.totalLatencyMs += latency;
+        if (latency > mStats.worstLatencyMs) {
+            mStats.worstLatencyMs = latency;
+        }
+        mHasPendingInput = false;
+    }
+
+    if (mLastPresent == 0) {
+        mStartTime = now;
+    } else {
+        const double frameMs = (now - mLastPresent) * 1000.0 / SDL_GetPerformanceFrequency();
+        mStats.frames++;
+        const double delta = frameMs - mStats.meanFrameMs;
+        mStats.meanFrameMs += delta / mStats.frames;
+        mStats.frameM2 += delta * (frameMs - mStats.meanFrameMs);
+        if (frameMs > mStats.worstFrameMs) {
+            mStats.worstFrameMs = frameMs;
+        }
+    }
+    mLastPresent = now;
+}
+
+const FrameStats& Display::getStats() const {
+    return mStats;
+}
+
+void Display::resetStats() {
+    mStats = FrameStats();
+    mStartTime = mLastPresent;
+}
+
+const char* Display::describe() const {
+    return mDescription;
+}
+
+void Display::printStats() const {
+    if (mStats.frames == 0) {
+        return;
+    }
+    const double seconds = (double)(mLastPresent - mStartTime) / SDL_GetPerformanceFrequency();
+    const double deviation = sqrt(mStats.frameM2 / mStats.frames);
+    printf("Display: %s\n", mDescription);
+    printf("  %.1f fps over %llu frames, frame time %.2f ms +/- %.2f ms, worst %.2f ms\n",
+        mStats.frames / seconds, mStats.frames, mStats.meanFrameMs, deviation, mStats.worstFrameMs);
+    if (mStats.inputs != 0) {
+        printf("  input to first frame showing it %.1f ms average, %.1f ms worst over %llu inputs\n",
+            mStats.totalLatencyMs / mStats.inputs, mStats.worstLatencyMs, mStats.inputs);
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include <SDL.h>
+#include <stdint.h>
+#include <limits.h>
+
+enum RendererBackend {
+    BACKEND_ACCELERATED,
+    BACKEND_SOFTWARE
+};
+
+struct DisplayOptions {
+    RendererBackend backend;
+    bool vsync;
+    unsigned int frameCap;      // frames per second without vsync, 0 for uncapped
+    bool renderToTexture;
+    float scale;                // initial window size relative to the default
+    bool linearFiltering;
+};
+
+// Defaults are accelerated, vsync, 60 fps cap, direct rendering at 1x.
+void setDefaultDisplayOptions(DisplayOptions& options);
+// Consumes args[i], and its value if it takes one, when it is a display
+// option. Returns false for anything else.
+bool parseDisplayOption(int argc, char* args[], int& i, DisplayOptions& options);
+void printDisplayUsage();
+
+// Frame statistics collected while a display is open.
+struct FrameStats {
+    unsigned long long frames;
+    double meanFrameMs;
+    double frameM2;             // sum of squared deviations (Welford)
+    double worstFrameMs;
+    unsigned long long inputs;
+    double totalLatencyMs;      // input event to the first present showing it
+    double worstLatencyMs;
+};
+
+// Owns the renderer for a window and paces and measures its frames. Drawing
+// happens in output pixels, which on a high-DPI display are more than the
+// window's size in points; layouts should use getWidth()/getHeight() and
+// mouse positions go through toLayout(). With render-to-texture the frame is
+// drawn into an offscreen target of the size the window opened with and
+// scaled onto the window, so the layout never changes.
+class Display {
+    private:
+        DisplayOptions mOptions;
+        SDL_Window* mWindow;
+        SDL_Renderer* mRenderer;
+        SDL_Texture* mTarget;
+        int mWidth;
+        int mHeight;
+        float mPixelRatioX;
+        float mPixelRatioY;
+
+        Uint32 mLastFrameTicks;
+        Uint64 mLastPresent;
+        Uint64 mStartTime;
+        bool mHasPendingInput;
+        Uint32 mPendingInput;   // SDL timestamp of the oldest unpresented input
+        unsigned int mPendingSequence;
+        FrameStats mStats;
+        char mDescription[96];
+
+        void recordFrame(const Uint64 now, const unsigned int inputsShown);
+        void updatePixelRatio();
+
+    public:
+        explicit Display(const DisplayOptions& options);
+        ~Display();
+
+        Display(const Display&) = delete;
+        Display& operator=(const Display&) = delete;
+
+        bool open(SDL_Window* window);
+        void close();
+
+        SDL_Renderer* getRenderer() const;
+        int getWidth() const;
+        int getHeight() const;
+
+        // Returns true when the event changed the size to lay out for. Size
+        // events arrive in bursts while the window is dragged, so callers
+        // should only note it and lay out once before their next frame.
+        bool handleEvent(const SDL_Event& event);
+        // Converts a mouse position from window points to layout pixels.
+        void toLayout(int& x, int& y) const;
+
+        // Returns true when a frame is due. Without vsync the frame cap is
+        // enforced here by sleeping, as the render loops used to do.
+        bool beginFrame();
+        // inputsShown is the sequence number of the last input the frame
+        // reflects. Frames drawn on the thread that handled the input pass
+        // the default, meaning everything marked so far.
+        void present(const unsigned int inputsShown = UINT_MAX);
+
+        // Called with the event timestamp of any input the user will expect
+        // to see acted upon. Input handled elsewhere, such as by the puzzle
+        // simulation, carries a sequence number, and the latency is only
+        // taken at the first present of a frame that reflects it.
+        void markInput(const Uint32 timestamp, const unsigned int sequence = 0);
+
+        const FrameStats& getStats() const;
+        // Starts a new measurement from the last present, so callers can
+        // report the statistics over intervals of their own.
+        void resetStats();
+        const char* describe() const;
+        void printStats() const;
+
+};
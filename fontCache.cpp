@@ -0,0 +1,63 @@
+#include "fontCache.h"
+#include "logger.h"
+
+FontCache gFontCache("assets/ARCADECLASSIC.ttf");
+
+FontCache::FontCache(const char* path)
+    : mPath(path) {
+
+}
+
+TTF_Font* FontCache::get(const int size) {
+    auto found = mFonts.find(size);
+    if (found != mFonts.end()) {
+        return found->second;
+    }
+
+    // A failed open is cached as well so it is not retried every frame.
+    TTF_Font* font = TTF_OpenFont(mPath, size);
+    if (font == nullptr) {
+        LOG_ERROR("Failed to load font at size %d! Error: %s", size, TTF_GetError());
+    }
+    mFonts[size] = font;
+    return font;
+}
+
+void FontCache::clear() {
+    for (auto& entry : mFonts) {
+        if (entry.second) {
+            TTF_CloseFont(entry.second);
+        }
+    }
+    mFonts.clear();
+}
+
+FontSession::FontSession()
+    : mOpen(false) {
+
+}
+
+FontSession::~FontSession() {
+    close();
+}
+
+bool FontSession::open() {
+    mOpen = TTF_Init() != -1;
+    return mOpen;
+}
+
+void FontSession::close() {
+    if (mOpen) {
+        gFontCache.clear();
+        TTF_Quit();
+        mOpen = false;
+    }
+}
+
+int quantizeFontSize(const int size) {
+    if (size < 8) {
+        return 8;
+    }
+    const int step = (size < 24) ? 2 : 4;
+    return size - size % step;
+}
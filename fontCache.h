@@ -0,0 +1,48 @@
+#pragma once
+#include <SDL_ttf.h>
+#include <unordered_map>
+
+// The game's font opened once per point size and kept until clear(), so a
+// layout change never has to reopen it. The fonts are closed by the
+// FontSession, never from the global's destructor.
+class FontCache {
+    private:
+        const char* mPath;
+        std::unordered_map<int, TTF_Font*> mFonts;
+
+    public:
+        explicit FontCache(const char* path);
+
+        FontCache(const FontCache&) = delete;
+        FontCache& operator=(const FontCache&) = delete;
+
+        TTF_Font* get(const int size);
+        // Must run before TTF_Quit.
+        void clear();
+
+};
+
+// Rounds a font size derived from the window size down to a coarser step,
+// so resizing the window only ever produces a handful of distinct sizes.
+int quantizeFontSize(const int size);
+
+extern FontCache gFontCache;
+
+// Keeps SDL_ttf initialised while it is open, and closes every font in
+// gFontCache before TTF_Quit when it is closed or goes out of scope, so no
+// exit path from main leaves the fonts to static destruction.
+class FontSession {
+    private:
+        bool mOpen;
+
+    public:
+        FontSession();
+        ~FontSession();
+
+        FontSession(const FontSession&) = delete;
+        FontSession& operator=(const FontSession&) = delete;
+
+        bool open();
+        void close();
+
+};
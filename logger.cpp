@@ -0,0 +1,153 @@
+#include "logger.h"
+#include <stdio.h>
+#include <stdarg.h>
+#include <chrono>
+
+Logger gLogger;
+
+static uint32_t currentTime() {
+    static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+static uint64_t hashText(const char* text) {
+    uint64_t hash = 14695981039346656037ull;
+    for (; *text != '\0'; ++text) {
+        hash = (hash ^ (unsigned char)*text) * 1099511628211ull;
+    }
+    return hash;
+}
+
+static const char* levelName(const int level) {
+    switch (level) {
+        case LOG_LEVEL_DEBUG: return "DEBUG";
+        case LOG_LEVEL_INFO: return "INFO";
+        case LOG_LEVEL_WARNING: return "WARNING";
+        default: return "ERROR";
+    }
+}
+
+Logger::Logger()
+    : mEnqueue(0), mDequeue(0), mDropped(0), mRunning(false) {
+    for (size_t i = 0; i < LOG_QUEUE_CAPACITY; ++i) {
+        mRecords[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+Logger::~Logger() {
+    stop();
+}
+
+void Logger::start() {
+    if (!mRunning.exchange(true)) {
+        mThread = std::thread(&Logger::run, this);
+    }
+}
+
+void Logger::stop() {
+    if (mRunning.exchange(false)) {
+        mThread.join();
+    }
+    drain();
+}
+
+void Logger::write(LogSite& site, const int level, const char* format, ...) {
+    char text[LOG_MESSAGE_SIZE];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+
+    const uint32_t now = currentTime();
+    const uint64_t hash = hashText(text);
+
+    if (hash == site.lastHash.load(std::memory_order_relaxed) && now - site.lastEmit.load(std::memory_order_relaxed) < DEDUP_WINDOW_MS) {
+        site.suppressed.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    if (now - site.windowStart.load(std::memory_order_relaxed) >= 1000) {
+        site.windowStart.store(now, std::memory_order_relaxed);
+        site.windowCount.store(0, std::memory_order_relaxed);
+    }
+    if (site.windowCount.fetch_add(1, std::memory_order_relaxed) >= SITE_BURST) {
+        site.suppressed.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    site.lastHash.store(hash, std::memory_order_relaxed);
+    site.lastEmit.store(now, std::memory_order_relaxed);
+    const uint32_t suppressed = site.suppressed.exchange(0, std::memory_order_relaxed);
+
+    if (!push(level, now, suppressed, text)) {
+        mDropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// Bounded queue after Vyukov: every slot carries a sequence number telling
+// producers and the consumer whose turn it is, so a producer only has to
+// win one compare-exchange on the enqueue position.
+bool Logger::push(const int level, const uint32_t time, const uint32_t suppressed, const char* text) {
+    size_t position = mEnqueue.load(std::memory_order_relaxed);
+    LogRecord* record;
+    while (true) {
+        record = &mRecords[position & (LOG_QUEUE_CAPACITY - 1)];
+        const size_t sequence = record->sequence.load(std::memory_order_acquire);
+        const intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+        if (difference == 0) {
+            if (mEnqueue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            return false;
+        } else {
+            position = mEnqueue.load(std::memory_order_relaxed);
+        }
+    }
+
+    record->level = level;
+    record->time = time;
+    record->suppressed = suppressed;
+    snprintf(record->text, sizeof(record->text), "%s", text);
+    record->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+size_t Logger::drain() {
+    size_t written = 0;
+    while (true) {
+        const size_t position = mDequeue.load(std::memory_order_relaxed);
+        LogRecord& record = mRecords[position & (LOG_QUEUE_CAPACITY - 1)];
+        if (record.sequence.load(std::memory_order_acquire) != position + 1) {
+            break;
+        }
+
+        fprintf(stdout, "[%6u.%03u] %-7s %s", record.time / 1000, record.time % 1000, levelName(record.level), record.text);
+        if (record.suppressed != 0) {
+            fprintf(stdout, " (%u similar suppressed)", record.suppressed);
+        }
+        fputc('\n', stdout);
+
+        record.sequence.store(position + LOG_QUEUE_CAPACITY, std::memory_order_release);
+        mDequeue.store(position + 1, std::memory_order_relaxed);
+        ++written;
+    }
+
+    const uint32_t dropped = mDropped.exchange(0, std::memory_order_relaxed);
+    if (dropped != 0) {
+        fprintf(stdout, "[logger] %u messages dropped, queue full\n", dropped);
+        ++written;
+    }
+    if (written != 0) {
+        fflush(stdout);
+    }
+    return written;
+}
+
+void Logger::run() {
+    while (mRunning.load(std::memory_order_acquire)) {
+        if (drain() == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <thread>
+
+#define LOG_LEVEL_DEBUG 0
+#define LOG_LEVEL_INFO 1
+#define LOG_LEVEL_WARNING 2
+#define LOG_LEVEL_ERROR 3
+
+// Calls below this level compile to nothing, arguments included.
+#ifndef LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define LOG_MIN_LEVEL LOG_LEVEL_INFO
+#else
+#define LOG_MIN_LEVEL LOG_LEVEL_DEBUG
+#endif
+#endif
+
+const size_t LOG_MESSAGE_SIZE = 240;
+const size_t LOG_QUEUE_CAPACITY = 256;
+
+// Per call site state for rate limiting and deduplication. Each LOG_* macro
+// owns one as a function-local static, so the bookkeeping needs no lookup.
+struct LogSite {
+    std::atomic<uint64_t> lastHash;
+    std::atomic<uint32_t> lastEmit;
+    std::atomic<uint32_t> windowStart;
+    std::atomic<uint32_t> windowCount;
+    std::atomic<uint32_t> suppressed;
+};
+
+struct LogRecord {
+    std::atomic<size_t> sequence;
+    int level;
+    uint32_t time;
+    uint32_t suppressed;
+    char text[LOG_MESSAGE_SIZE];
+};
+
+// Leveled logger that never blocks or flushes on the calling thread.
+// Messages are formatted into a bounded lock-free ring (several producers,
+// one consumer) and written out in batches by a background thread; when
+// the ring is full the message is dropped and counted instead.
+//
+// A call site repeating the same text is muted for DEDUP_WINDOW_MS and a
+// call site is allowed SITE_BURST messages per second; what was held back
+// is reported with the next message that gets through.
+class Logger {
+    static_assert((LOG_QUEUE_CAPACITY & (LOG_QUEUE_CAPACITY - 1)) == 0, "Log queue capacity must be a power of two");
+
+    private:
+        static const uint32_t DEDUP_WINDOW_MS = 1000;
+        static const uint32_t SITE_BURST = 5;
+
+        LogRecord mRecords[LOG_QUEUE_CAPACITY];
+        alignas(64) std::atomic<size_t> mEnqueue;
+        alignas(64) std::atomic<size_t> mDequeue;
+        std::atomic<uint32_t> mDropped;
+        std::atomic<bool> mRunning;
+        std::thread mThread;
+
+        bool push(const int level, const uint32_t time, const uint32_t suppressed, const char* text);
+        size_t drain();
+        void run();
+
+    public:
+        Logger();
+        ~Logger();
+
+        Logger(const Logger&) = delete;
+        Logger& operator=(const Logger&) = delete;
+
+        void start();
+        // Writes out everything still queued and joins the thread.
+        void stop();
+
+        void write(LogSite& site, const int level, const char* format, ...)
+#ifdef __GNUC__
+            __attribute__((format(printf, 4, 5)))
+#endif
+            ;
+
+};
+
+extern Logger gLogger;
+
+#define LOG_AT(level, ...) \
+    do { \
+        if ((level) >= LOG_MIN_LEVEL) { \
+            static LogSite logSite; \
+            gLogger.write(logSite, (level), __VA_ARGS__); \
+        } \
+    } while (0)
+
+#define LOG_DEBUG(...) LOG_AT(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define LOG_INFO(...) LOG_AT(LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG_WARNING(...) LOG_AT(LOG_LEVEL_WARNING, __VA_ARGS__)
+#define LOG_ERROR(...) LOG_AT(LOG_LEVEL_ERROR, __VA_ARGS__)
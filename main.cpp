@@ -1,88 +1,78 @@
 #include <SDL.h>
 #include <SDL_ttf.h>
 #include <SDL_mixer.h>
-#include <iostream>
 #include <vector>
 #include <algorithm>
 #include <functional>
 #include <time.h>
+#include <stdio.h>
 #include "tile.h"
 #include "stopwatch.h"
 #include "button.h"
+#include "numberLabel.h"
 #include "startMenu.h"
+#include "textureCache.h"
+#include "pool.h"
+#include "boardKernels.h"
+#include "puzzleSimulation.h"
+#include "display.h"
+#include "logger.h"
+#include "stressTest.h"
+#include "fontCache.h"
 
-typedef std::vector<std::vector<Tile>> tileArray;
+typedef TileGrid tileArray;
 
 Mix_Chunk* gMoveSound = nullptr;
 Mix_Chunk* gVictorySound = nullptr;
 
 static void forEachTile(tileArray& tiles, std::function<void(tileArray&, const int, const int)>&& func) {
     for (int row = 0; row < tiles.size(); ++row) {
-        for (int col = 0; col < tiles[row].size(); ++col) {
+        for (int col = 0; col < tiles.size(); ++col) {
             func(tiles, row, col);
         }
     }
 }
 
-static inline bool inBounds(const int row, const int col, const int maxRow, const int maxCol) {
-    return !(row < 0 || row > maxRow || col < 0 || col > maxCol);
-}
-
-static bool isEmptyTileInNeighbours(tileArray& tiles, const int row, const int col, Tile* emptyTile) {
-    static const int deltas[4][2] = {{-1, 0}, {0, 1}, {1, 0}, {0, -1}};
-
-    for (int i = 0; i < 4; ++i) {
-        if (inBounds(row + deltas[i][0], col + deltas[i][1], tiles.size() - 1, tiles[0].size() - 1)) {
-            if (emptyTile == &tiles[row + deltas[i][0]][col + deltas[i][1]]) {
-                return true;
-            }
-        }
-    }
-
-    return false;
-}
-
-unsigned int playMenu(SDL_Renderer* renderer, bool* exit, const unsigned int SCREEN_WIDTH, const unsigned int SCREEN_HEIGHT) {
-    const unsigned int NUMBER_OF_ROW_ELEMENTS = 1;
+unsigned int playMenu(Display& display, bool* exit) {
+    SDL_Renderer* renderer = display.getRenderer();
     const unsigned int NUMBER_OF_COL_ELEMENTS = 3;
-    const unsigned int NUMBER_OF_ROW_BORDERS = NUMBER_OF_ROW_ELEMENTS + 1;
-    const unsigned int NUMBER_OF_COL_BORDERS = NUMBER_OF_COL_ELEMENTS + 1;
-    const unsigned int BORDER_THICKNESS = 20;
-
-    const unsigned int BUTTON_WIDTH = SCREEN_WIDTH - 2 * BORDER_THICKNESS;
-    const unsigned int BUTTON_HEIGHT = (SCREEN_HEIGHT - NUMBER_OF_COL_BORDERS * BORDER_THICKNESS) / NUMBER_OF_COL_ELEMENTS;
 
     const SDL_Color FONT_COLOUR = {0, 0, 0, 255};
     const SDL_Color BUTTON_COLOUR = {255, 255, 102, 255};
     const SDL_Color BUTTON_DOWN_COLOUR = {50, 255, 100, 255};
 
-    const int fontSize = BUTTON_HEIGHT - 40;
-    TTF_Font* font = TTF_OpenFont("assets/ARCADECLASSIC.ttf", fontSize);
-    if (font == nullptr) {
-        std::cout << "Failed to load font! Error: " << TTF_GetError() << std::endl;
+    Pool<Button> buttons(NUMBER_OF_COL_ELEMENTS);
+    for (int row = 0; row < NUMBER_OF_COL_ELEMENTS; ++row) {
+        buttons.emplace(SDL_Rect{0, 0, 0, 0}, BUTTON_COLOUR, 0, FONT_COLOUR);
     }
 
-    const char* buttonTexts[3] = {"3x3", "4x4", "5x5"};
-
-    int startX = BORDER_THICKNESS;
-    int startY = 0;
+    auto layout = [&]() {
+        const unsigned int SCREEN_WIDTH = display.getWidth();
+        const unsigned int SCREEN_HEIGHT = display.getHeight();
+        const unsigned int NUMBER_OF_COL_BORDERS = NUMBER_OF_COL_ELEMENTS + 1;
+        const unsigned int BORDER_THICKNESS = SCREEN_WIDTH / 20;
+
+        const unsigned int BUTTON_WIDTH = SCREEN_WIDTH - 2 * BORDER_THICKNESS;
+        const unsigned int BUTTON_HEIGHT = (SCREEN_HEIGHT - NUMBER_OF_COL_BORDERS * BORDER_THICKNESS) / NUMBER_OF_COL_ELEMENTS;
+        const int fontSize = quantizeFontSize(BUTTON_HEIGHT * 3 / 4);
+
+        int startY = 0;
+        for (int row = 0; row < NUMBER_OF_COL_ELEMENTS; ++row) {
+            startY += BORDER_THICKNESS;
+            SDL_Rect rect = {(int)BORDER_THICKNESS, startY, (int)BUTTON_WIDTH, (int)BUTTON_HEIGHT};
+            buttons[row].setLayout(renderer, rect, fontSize);
+            startY += BUTTON_HEIGHT;
+        }
+    };
+    layout();
 
-    std::vector<Button> buttons;
+    const char* buttonTexts[3] = {"3x3", "4x4", "5x5"};
     for (int row = 0; row < NUMBER_OF_COL_ELEMENTS; ++row) {
-        startY += BORDER_THICKNESS;
-        SDL_Rect rect = {startX, startY, (int)BUTTON_WIDTH, (int)BUTTON_HEIGHT};
-        Button button(rect, BUTTON_COLOUR, font, FONT_COLOUR);
-        button.loadTexture(renderer, buttonTexts[row]);
-        buttons.push_back(button);
-        startY += BUTTON_HEIGHT;
+        buttons[row].loadTexture(renderer, buttonTexts[row]);
     }
 
-    const unsigned int FPS = 60;
-    const float milliSecondsPerFrame = 1000 / FPS;
-    float lastTimeRendered = SDL_GetTicks();
-    float deltaTimeRendered;
-
     bool stop = false;
+    bool layoutChanged = false;
     SDL_Event event;
     unsigned int difficulty = 0;
 
@@ -92,9 +82,14 @@ unsigned int playMenu(SDL_Renderer* renderer, bool* exit, const unsigned int SCR
                 *exit = true;
                 stop = true;
             }
+            if (display.handleEvent(event)) {
+                layoutChanged = true;
+            }
             if (event.type == SDL_MOUSEBUTTONDOWN) {
-                int x, y;
-                SDL_GetMouseState(&x, &y);
+                display.markInput(event.button.timestamp);
+                int x = event.button.x;
+                int y = event.button.y;
+                display.toLayout(x, y);
                 for (int i = 0; i < NUMBER_OF_COL_ELEMENTS; ++i) {
                     if (buttons[i].isMouseInside(x, y)) {
                         buttons[i].changeColourTo(BUTTON_DOWN_COLOUR);
@@ -111,9 +106,12 @@ unsigned int playMenu(SDL_Renderer* renderer, bool* exit, const unsigned int SCR
             }
         }
 
-        deltaTimeRendered = SDL_GetTicks() - lastTimeRendered;
-        if (deltaTimeRendered > milliSecondsPerFrame) {
-            lastTimeRendered = SDL_GetTicks();
+        if (layoutChanged) {
+            layout();
+            layoutChanged = false;
+        }
+
+        if (display.beginFrame()) {
             SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
             SDL_RenderClear(renderer);
 
@@ -121,178 +119,210 @@ unsigned int playMenu(SDL_Renderer* renderer, bool* exit, const unsigned int SCR
                 button.render(renderer);
             }
 
-            SDL_RenderPresent(renderer);
-
-        } else {
-            SDL_Delay(milliSecondsPerFrame - deltaTimeRendered);
+            display.present();
         }
     }
 
-    for (auto& button : buttons) {
-        button.free();
-    }
-
-    TTF_CloseFont(font);
-    font = nullptr;
-
     return difficulty;
 }
 
-void playPuzzle(SDL_Renderer* renderer, bool* exit, const unsigned int DIFFICULTY, const unsigned int SCREEN_WIDTH, const unsigned int SCREEN_HEIGHT) {
+static void renderCentred(SDL_Renderer* renderer, const TextureHandle& text, const int width, const int height) {
+    if (text.get() != nullptr) {
+        SDL_Rect textRect = {
+            (width - text.getWidth()) / 2,
+            (height - text.getHeight()) / 2,
+            text.getWidth(),
+            text.getHeight()
+        };
+        SDL_RenderCopy(renderer, text.get(), NULL, &textRect);
+    }
+}
+
+void playPuzzle(Display& display, bool* exit, const BoardOps& ops) {
+    SDL_Renderer* renderer = display.getRenderer();
+    const unsigned int DIFFICULTY = ops.size;
     const unsigned int NUMBER_OF_ROW_ELEMENTS = DIFFICULTY;
     const unsigned int NUMBER_OF_COL_ELEMENTS = DIFFICULTY + 2;
     const unsigned int NUMBER_OF_ROW_BORDERS = NUMBER_OF_ROW_ELEMENTS + 1;
     const unsigned int NUMBER_OF_COL_BORDERS = NUMBER_OF_COL_ELEMENTS + 1;
-    const unsigned int BORDER_THICKNESS = 6;
-    const unsigned int TILE_WIDTH = (SCREEN_WIDTH - NUMBER_OF_ROW_BORDERS * BORDER_THICKNESS) / NUMBER_OF_ROW_ELEMENTS;
-    const unsigned int TILE_HEIGHT = (SCREEN_HEIGHT - NUMBER_OF_COL_BORDERS * BORDER_THICKNESS) / NUMBER_OF_COL_ELEMENTS;
-
-    const unsigned int STOPWATCH_WIDTH = SCREEN_WIDTH - 2 * BORDER_THICKNESS;
-    const unsigned int STOPWATCH_HEIGHT = TILE_HEIGHT;
-
-    const unsigned int BUTTON_WIDTH = SCREEN_WIDTH - 2 * BORDER_THICKNESS;
-    const unsigned int BUTTON_HEIGHT = TILE_HEIGHT;
 
     const SDL_Color TILE_COLOUR = {0, 191, 255, 255};
     const SDL_Color TILE_COMPLETION_COLOUR = {50, 255, 100, 255};
     const SDL_Color EMPTY_TILE_COLOUR = {0, 0, 0, 255};
     const SDL_Color FONT_COLOUR = {0, 0, 0, 255};
     const SDL_Color STOPWATCH_COLOUR = {255, 50, 50, 255};
+    const SDL_Color ESTIMATE_COLOUR = {255, 165, 0, 255};
     const SDL_Color BUTTON_COLOUR = {255, 255, 102, 255};
     const SDL_Color BUTTON_DOWN_COLOUR = {50, 255, 100, 255};
-
-    const int fontSize = TILE_HEIGHT - 40;
-    TTF_Font* font = TTF_OpenFont("assets/ARCADECLASSIC.ttf", fontSize);
-    if (font == nullptr) {
-        std::cout << "Failed to load font! Error: " << TTF_GetError() << std::endl;
+    const SDL_Color VICTORY_COLOUR = {255, 215, 0, 255};
+    const SDL_Color PAUSE_COLOUR = {255, 255, 255, 255};
+
+    const SDL_Rect NO_RECT = {0, 0, 0, 0};
+    Stopwatch stopwatch(NO_RECT, STOPWATCH_COLOUR, 0, FONT_COLOUR);
+    NumberLabel estimateLabel(NO_RECT, ESTIMATE_COLOUR, 0, FONT_COLOUR);
+    tileArray tiles(DIFFICULTY);
+    for (int number = 1; number <= DIFFICULTY * DIFFICULTY; ++number) {
+        tiles.emplace(NO_RECT, number == DIFFICULTY * DIFFICULTY ? EMPTY_TILE_COLOUR : TILE_COLOUR, 0, FONT_COLOUR, number);
     }
+    Button menuButton(NO_RECT, BUTTON_COLOUR, 0, FONT_COLOUR);
+    TextureHandle victoryText;
+    TextureHandle pauseText;
 
-    int startX = BORDER_THICKNESS;
-    int startY = BORDER_THICKNESS;
-    SDL_Rect rect = {startX, startY, (int)STOPWATCH_WIDTH, (int)STOPWATCH_HEIGHT};
-    Stopwatch stopwatch(rect, STOPWATCH_COLOUR, font, FONT_COLOUR);
+    SDL_Point slots[BOARD_MAX_CELLS];
+    unsigned int cellWidth = 0;
+    unsigned int cellHeight = 0;
 
-    tileArray tiles;
-    startY += TILE_HEIGHT;
-    for (int row = 0; row < DIFFICULTY; ++row) {
-        std::vector<Tile> tileRow;
-        startY += BORDER_THICKNESS;
-        startX = 0;
-        for (int col = 0; col < DIFFICULTY; ++col) {
-            startX += BORDER_THICKNESS;
-            rect = {startX, startY, (int)TILE_WIDTH, (int)TILE_HEIGHT};
-            SDL_Color colour;
-            if (row == DIFFICULTY - 1 && col == DIFFICULTY - 1) {
-                colour = EMPTY_TILE_COLOUR;
-            } else {
-                colour = TILE_COLOUR;
-            }
-            int number = row * DIFFICULTY + col + 1;
+    auto layout = [&]() {
+        const unsigned int SCREEN_WIDTH = display.getWidth();
+        const unsigned int SCREEN_HEIGHT = display.getHeight();
+        const unsigned int BORDER_THICKNESS = std::max(2u, SCREEN_WIDTH * 3 / 205);
+        const unsigned int TILE_WIDTH = (SCREEN_WIDTH - NUMBER_OF_ROW_BORDERS * BORDER_THICKNESS) / NUMBER_OF_ROW_ELEMENTS;
+        const unsigned int TILE_HEIGHT = (SCREEN_HEIGHT - NUMBER_OF_COL_BORDERS * BORDER_THICKNESS) / NUMBER_OF_COL_ELEMENTS;
 
-            Tile tile(rect, colour, font, FONT_COLOUR, number);
-            const char* numberStr = std::to_string(number).c_str();
-            tile.loadTexture(renderer, numberStr);
-            tileRow.push_back(tile);
+        const unsigned int STOPWATCH_WIDTH = (SCREEN_WIDTH - 3 * BORDER_THICKNESS) * 3 / 5;
+        const unsigned int ESTIMATE_WIDTH = SCREEN_WIDTH - 3 * BORDER_THICKNESS - STOPWATCH_WIDTH;
+        const unsigned int BUTTON_WIDTH = SCREEN_WIDTH - 2 * BORDER_THICKNESS;
 
-            startX += TILE_WIDTH;
-        }
-        startY += TILE_HEIGHT;
-        tiles.push_back(tileRow);
-    }
+        const int fontSize = quantizeFontSize(TILE_HEIGHT * 3 / 5);
+        const int headerFontSize = quantizeFontSize(TILE_HEIGHT * 3 / 10);
 
-    startX = BORDER_THICKNESS;
-    startY += BORDER_THICKNESS;
-    rect = {startX, startY, (int)BUTTON_WIDTH, (int)BUTTON_HEIGHT};
-    Button menuButton(rect, BUTTON_COLOUR, font, FONT_COLOUR);
-    menuButton.loadTexture(renderer, "Menu");
+        int startX = BORDER_THICKNESS;
+        int startY = BORDER_THICKNESS;
+        stopwatch.setLayout(renderer, {startX, startY, (int)STOPWATCH_WIDTH, (int)TILE_HEIGHT}, headerFontSize);
+        estimateLabel.setLayout(renderer, {startX + (int)STOPWATCH_WIDTH + (int)BORDER_THICKNESS, startY, (int)ESTIMATE_WIDTH, (int)TILE_HEIGHT}, headerFontSize);
 
-    const unsigned int FPS = 60;
-    const float milliSecondsPerFrame = 1000 / FPS;
-    float lastTimeRendered = SDL_GetTicks();
-    float deltaTimeRendered;
-
-    const unsigned int pixelsPerSecond = 500;
-    const float milliSecondsPerPixel = 1000 / pixelsPerSecond;
-    float lastTimeMoved;
-    float deltaTimeMoved;
-
-    Tile* movingTile = nullptr;
-    bool doneMoving = true;
-    Tile* emptyTile = &tiles[DIFFICULTY - 1][DIFFICULTY - 1];
-    bool selected = false;
-    int tempXPosition;
-    int tempYPosition;
-
-    const unsigned int TOTAL_SWAPS = 1000;
-    int emptyTileRow = DIFFICULTY - 1;
-    int emptyTileCol = DIFFICULTY - 1;
-    std::vector<std::vector<int>> neighbours;
-    srand(time(NULL));
-    const int deltas[4][2] = {{-1, 0}, {0, 1}, {1, 0}, {0, -1}};
-    for (int swap = 0; swap < TOTAL_SWAPS; ++swap) {
-        for (int i = 0; i < 4; ++i) {
-            const int deltaRow = deltas[i][0];
-            const int deltaCol = deltas[i][1];
-            if (inBounds(emptyTileRow + deltaRow, emptyTileCol + deltaCol, tiles.size() - 1, tiles[0].size() - 1)) {
-                std::vector<int> neighbour = {emptyTileRow + deltaRow, emptyTileCol + deltaCol};
-                neighbours.push_back(neighbour);
+        startY += TILE_HEIGHT;
+        for (int row = 0; row < DIFFICULTY; ++row) {
+            startY += BORDER_THICKNESS;
+            startX = 0;
+            for (int col = 0; col < DIFFICULTY; ++col) {
+                startX += BORDER_THICKNESS;
+                slots[row * DIFFICULTY + col] = {startX, startY};
+                tiles[row][col].setLayout(renderer, {startX, startY, (int)TILE_WIDTH, (int)TILE_HEIGHT}, fontSize);
+                startX += TILE_WIDTH;
             }
+            startY += TILE_HEIGHT;
         }
-        const int randomIndex = rand() % neighbours.size();
-        const int row = neighbours[randomIndex][0];
-        const int col = neighbours[randomIndex][1];
-        tempXPosition = emptyTile->getXPosition();
-        tempYPosition = emptyTile->getYPosition();
-        emptyTile->setPositionTo(tiles[row][col].getXPosition(), tiles[row][col].getYPosition());
-        tiles[row][col].setPositionTo(tempXPosition, tempYPosition);
-        std::iter_swap(&tiles[row][col], emptyTile);
-        emptyTile = &tiles[row][col];
-        emptyTileRow = row;
-        emptyTileCol = col;
-        neighbours.clear();
-    }
+
+        startY += BORDER_THICKNESS;
+        menuButton.setLayout(renderer, {(int)BORDER_THICKNESS, startY, (int)BUTTON_WIDTH, (int)TILE_HEIGHT}, fontSize);
+
+        victoryText = gTextureCache.acquire(renderer, quantizeFontSize(BUTTON_WIDTH * 3 / 20), VICTORY_COLOUR, "You Did It!");
+        pauseText = gTextureCache.acquire(renderer, quantizeFontSize(BUTTON_WIDTH / 10), PAUSE_COLOUR, "PAUSED - Press ESC to continue");
+
+        cellWidth = TILE_WIDTH + BORDER_THICKNESS;
+        cellHeight = TILE_HEIGHT + BORDER_THICKNESS;
+    };
+    layout();
+
+    estimateLabel.loadGlyphs(renderer, "Left ");
+    forEachTile(tiles, [renderer](tileArray& tiles, const int row, const int col) {
+        tiles[row][col].loadTexture(renderer, std::to_string(tiles[row][col].getNumber()).c_str());
+    });
+    menuButton.loadTexture(renderer, "Menu");
+
+    // Tiles slide at the same speed in cells per second whatever the window
+    // size, so the speed is fixed by the layout the game starts with.
+    const float pixelsPerSecond = 500 * display.getWidth() / 410.0f;
+    PuzzleSimulation simulation(ops, cellWidth * 1000 / pixelsPerSecond, cellHeight * 1000 / pixelsPerSecond);
+    simulation.start();
 
     bool stop = false;
+    bool layoutChanged = false;
     SDL_Event event;
-    bool checkSolved = false;
     bool solved = false;
-    bool menuButtonPressed = false;
     bool isPaused = false;
-
-    stopwatch.start();
+    bool menuButtonPressed = false;
+    simulation.updateFrame();
+    unsigned int moveCount = simulation.getFrame().moveCount;
 
     while (!stop) {
+        if (layoutChanged) {
+            layout();
+            layoutChanged = false;
+        }
+
+        simulation.updateFrame();
+        const PuzzleFrame& frame = simulation.getFrame();
+        tiles.place(frame.cells, frame.emptyIndex, frame.movingIndex, frame.progress, slots);
+
+        if (frame.moveCount != moveCount) {
+            // A new game resets the count, which is not a move.
+            const bool moved = frame.moveCount > moveCount;
+            moveCount = frame.moveCount;
+            if (moved && gMoveSound) {
+                Mix_PlayChannel(-1, gMoveSound, 0);
+            }
+        }
+
+        if (frame.paused != isPaused) {
+            isPaused = frame.paused;
+            LOG_INFO("Game %s", isPaused ? "paused" : "resumed");
+        }
+
+        if (!frame.solved && solved) {
+            solved = false;
+            forEachTile(tiles, [DIFFICULTY, &TILE_COLOUR](tileArray& tiles, const int row, const int col) {
+                if (row * DIFFICULTY + col + 1 != DIFFICULTY * DIFFICULTY) {
+                    tiles[row][col].changeColourTo(TILE_COLOUR);
+                }
+            });
+        }
+
+        if (frame.solved && !solved) {
+            solved = true;
+            forEachTile(tiles, [DIFFICULTY, &TILE_COMPLETION_COLOUR](tileArray& tiles, const int row, const int col) {
+                if (row * DIFFICULTY + col + 1 != DIFFICULTY * DIFFICULTY) {
+                    tiles[row][col].changeColourTo(TILE_COMPLETION_COLOUR);
+                }
+            });
+            if (gVictorySound) {
+                Mix_PlayChannel(-1, gVictorySound, 0);
+            }
+        }
+
         while (SDL_PollEvent(&event) != 0) {
             if (event.type == SDL_QUIT) {
                 stop = true;
                 *exit = true;
             }
+            if (display.handleEvent(event)) {
+                layoutChanged = true;
+            }
             if (event.type == SDL_KEYDOWN) {
+                unsigned int sequence = 0;
                 if (event.key.keysym.sym == SDLK_ESCAPE) {
-                    isPaused = !isPaused;
-                    std::cout << "Game " << (isPaused ? "paused" : "resumed") << std::endl;
-                    if (isPaused) {
-                        stopwatch.pause();
-                    } else {
-                        stopwatch.resume();
-                    }
+                    sequence = simulation.post({INPUT_TOGGLE_PAUSE, 0});
+                }
+                if (event.key.keysym.sym == SDLK_h) {
+                    sequence = simulation.post({INPUT_TOGGLE_AUTOPLAY, 0});
+                }
+                if (event.key.keysym.sym == SDLK_n) {
+                    sequence = simulation.post({INPUT_NEW_GAME, 0});
+                }
+                if (sequence != 0) {
+                    display.markInput(event.key.timestamp, sequence);
                 }
             }
-            if (doneMoving && !isPaused) {
+            if (frame.movingIndex == -1 && !isPaused) {
                 if (event.type == SDL_MOUSEBUTTONDOWN) {
-                    int x, y;
-                    SDL_GetMouseState(&x, &y);
+                    int x = event.button.x;
+                    int y = event.button.y;
+                    display.toLayout(x, y);
                     if (!solved) {
-                        forEachTile(tiles, [x, y, &movingTile, emptyTile, &selected, &doneMoving, &lastTimeMoved](tileArray& tiles, const int row, const int col) {
-                            if (tiles[row][col].isMouseInside(x, y)) {
-                                if (isEmptyTileInNeighbours(tiles, row, col, emptyTile)) {
-                                    movingTile = &tiles[row][col];
-                                    selected = true;
-                                    doneMoving = false;
-                                    lastTimeMoved = SDL_GetTicks();
+                        // Only tiles next to the blank can move, so only
+                        // those clicks are queued and timed.
+                        int moves[4];
+                        const int count = ops.generateMoves(frame.emptyIndex, moves, DIFFICULTY);
+                        for (int i = 0; i < count; ++i) {
+                            const int number = frame.cells[moves[i]];
+                            if (tiles[(number - 1) / DIFFICULTY][(number - 1) % DIFFICULTY].isMouseInside(x, y)) {
+                                const unsigned int sequence = simulation.post({INPUT_CLICK_TILE, moves[i]});
+                                if (sequence != 0) {
+                                    display.markInput(event.button.timestamp, sequence);
                                 }
                             }
-                        });
+                        }
                     }
                     if (menuButton.isMouseInside(x, y)) {
                         menuButton.changeColourTo(BUTTON_DOWN_COLOUR);
@@ -307,236 +337,165 @@ void playPuzzle(SDL_Renderer* renderer, bool* exit, const unsigned int DIFFICULT
             }
         }
 
-        if (selected && movingTile != nullptr) {
-            tempXPosition = movingTile->getXPosition();
-            tempYPosition = movingTile->getYPosition();
-            selected = false;
-        }
-
-        if (movingTile != nullptr && !isPaused) {
-            deltaTimeMoved = SDL_GetTicks() - lastTimeMoved;
-            if (deltaTimeMoved > milliSecondsPerPixel) {
-                int pixelsToMove = deltaTimeMoved / milliSecondsPerPixel;
-                for (int i = 0; i < pixelsToMove; ++i) {
-                    doneMoving = movingTile->moveTo(emptyTile->getXPosition(), emptyTile->getYPosition());
-                    if (doneMoving) {
-                        emptyTile->setPositionTo(tempXPosition, tempYPosition);
-                        std::iter_swap(movingTile, emptyTile);
-                        emptyTile = movingTile;
-                        movingTile = nullptr;
-                        checkSolved = true;
-                        if (gMoveSound) {
-                            Mix_PlayChannel(-1, gMoveSound, 0);
-                        }
-                        break;
-                    }
-                }
-                lastTimeMoved = SDL_GetTicks();
-            }
-        }
-
-        if (checkSolved) {
-            solved = true;
-            forEachTile(tiles, [&solved, DIFFICULTY](tileArray& tiles, const int row, const int col) {
-                const int number = row * DIFFICULTY + col + 1;
-                if (tiles[row][col].getNumber() != number) {
-                    solved = false;
-                }
-            });
-            if (solved && gVictorySound) {
-                Mix_PlayChannel(-1, gVictorySound, 0);
-            }
-            checkSolved = false;
-        }
-
-        if (solved) {
-            forEachTile(tiles, [emptyTile, &TILE_COMPLETION_COLOUR](tileArray& tiles, const int row, const int col) {
-                if (emptyTile != &tiles[row][col]) {
-                    tiles[row][col].changeColourTo(TILE_COMPLETION_COLOUR);
-                }
-            });
-
-            TTF_Font* victoryFont = TTF_OpenFont("assets/ARCADECLASSIC.ttf", 60);
-            if (victoryFont) {
-                SDL_Color textColor = {255, 215, 0, 255};
-                SDL_Surface* textSurface = TTF_RenderText_Solid(victoryFont, "You Did It!", textColor);
-                if (textSurface) {
-                    SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-                    if (textTexture) {
-                        SDL_Rect textRect = {
-                            (SCREEN_WIDTH - textSurface->w) / 2,
-                            (SCREEN_HEIGHT - textSurface->h) / 2,
-                            textSurface->w,
-                            textSurface->h
-                        };
-                        SDL_RenderCopy(renderer, textTexture, NULL, &textRect);
-                        SDL_DestroyTexture(textTexture);
-                    }
-                    SDL_FreeSurface(textSurface);
-                }
-                TTF_CloseFont(victoryFont);
-            }
-        } else if (!isPaused) {
-            stopwatch.calculateTime(renderer);
-        }
+        stopwatch.showTime(renderer, frame.elapsedTime);
+        estimateLabel.setValue(frame.estimate);
 
-        deltaTimeRendered = SDL_GetTicks() - lastTimeRendered;
-        if (deltaTimeRendered > milliSecondsPerFrame) {
-            lastTimeRendered = SDL_GetTicks();
+        if (display.beginFrame()) {
             SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
             SDL_RenderClear(renderer);
 
             stopwatch.render(renderer);
+            estimateLabel.render(renderer);
 
-            forEachTile(tiles, [renderer, emptyTile](tileArray& tiles, const int row, const int col) {
-                if (emptyTile != &tiles[row][col]) {
+            forEachTile(tiles, [renderer, DIFFICULTY](tileArray& tiles, const int row, const int col) {
+                if (row * DIFFICULTY + col + 1 != DIFFICULTY * DIFFICULTY) {
                     tiles[row][col].render(renderer);
                 }
             });
 
             menuButton.render(renderer);
 
+            if (solved) {
+                renderCentred(renderer, victoryText, display.getWidth(), display.getHeight());
+            }
+
             if (isPaused) {
                 SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
                 SDL_SetRenderDrawColor(renderer, 0, 0, 0, 128);
-                SDL_Rect pauseRect = {0, 0, SCREEN_WIDTH, SCREEN_HEIGHT};
+                SDL_Rect pauseRect = {0, 0, display.getWidth(), display.getHeight()};
                 SDL_RenderFillRect(renderer, &pauseRect);
 
-                TTF_Font* pauseFont = TTF_OpenFont("assets/ARCADECLASSIC.ttf", 40);
-                if (pauseFont) {
-                    SDL_Color textColor = {255, 255, 255, 255};
-                    const char* pauseText = "PAUSED - Press ESC to continue";
-                    SDL_Surface* textSurface = TTF_RenderText_Solid(pauseFont, pauseText, textColor);
-                    if (textSurface) {
-                        SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-                        if (textTexture) {
-                            SDL_Rect textRect = {
-                                (SCREEN_WIDTH - textSurface->w) / 2,
-                                (SCREEN_HEIGHT - textSurface->h) / 2,
-                                textSurface->w,
-                                textSurface->h
-                            };
-                            SDL_RenderCopy(renderer, textTexture, NULL, &textRect);
-                            SDL_DestroyTexture(textTexture);
-                        }
-                        SDL_FreeSurface(textSurface);
-                    }
-                    TTF_CloseFont(pauseFont);
-                } else {
-                    std::cout << "Failed to load pause font! Error: " << TTF_GetError() << std::endl;
-                }
+                renderCentred(renderer, pauseText, display.getWidth(), display.getHeight());
             }
 
-            SDL_RenderPresent(renderer);
-
-        } else {
-            SDL_Delay(milliSecondsPerFrame - deltaTimeRendered);
+            display.present(frame.inputsHandled);
         }
     }
 
+    simulation.stop();
+
     if (solved) {
-        std::cout << "Solved!" << std::endl;
+        LOG_INFO("Solved!");
     }
-
-    forEachTile(tiles, [](tileArray& tiles, const int row, const int col) {
-        tiles[row][col].free();
-    });
-    stopwatch.free();
-
-    TTF_CloseFont(font);
-    font = nullptr;
 }
 
 int main( int argc, char* args[] ) {
+    gLogger.start();
+
     const unsigned int SCREEN_WIDTH = 410;
     const unsigned int SCREEN_HEIGHT = 600;
 
+    DisplayOptions displayOptions;
+    StressOptions stressOptions;
+    setDefaultDisplayOptions(displayOptions);
+    setDefaultStressOptions(stressOptions);
+    for (int i = 1; i < argc; ++i) {
+        if (!parseDisplayOption(argc, args, i, displayOptions) && !parseStressOption(argc, args, i, stressOptions)) {
+            fprintf(stderr, "Usage: %s [options]\n", args[0]);
+            printDisplayUsage();
+            printStressUsage();
+            return -1;
+        }
+    }
+
     if (SDL_Init(SDL_INIT_VIDEO) != 0) {
-        std::cout << "SDL could not initialise! Error: " << SDL_GetError() << std::endl;
+        LOG_ERROR("SDL could not initialise! Error: %s", SDL_GetError());
         return -1;
     }
 
-    if (TTF_Init() == -1) {
-        std::cout << "SDL_ttf could not initialise! Error: " << TTF_GetError() << std::endl;
+    FontSession fonts;
+    if (!fonts.open()) {
+        LOG_ERROR("SDL_ttf could not initialise! Error: %s", TTF_GetError());
         return -1;
     }
 
     if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
-        std::cout << "SDL_mixer could not initialize! Error: " << Mix_GetError() << std::endl;
+        LOG_ERROR("SDL_mixer could not initialize! Error: %s", Mix_GetError());
         return -1;
     }
 
     gMoveSound = Mix_LoadWAV("assets/move.wav");
     if (!gMoveSound) {
-        std::cout << "Failed to load move sound effect! Error: " << Mix_GetError() << std::endl;
+        LOG_ERROR("Failed to load move sound effect! Error: %s", Mix_GetError());
     }
 
     gVictorySound = Mix_LoadWAV("assets/victory.wav");
     if (!gVictorySound) {
-        std::cout << "Failed to load victory sound effect! Error: " << Mix_GetError() << std::endl;
+        LOG_ERROR("Failed to load victory sound effect! Error: %s", Mix_GetError());
     }
 
-    SDL_Window* window = SDL_CreateWindow("Puzzle Game", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+    SDL_Window* window = SDL_CreateWindow("Puzzle Game", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH * displayOptions.scale, SCREEN_HEIGHT * displayOptions.scale, SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI);
     if (window == nullptr) {
-        std::cout << "SDL could not create window! Error: " << SDL_GetError() << std::endl;
+        LOG_ERROR("SDL could not create window! Error: %s", SDL_GetError());
         return -1;
     }
 
-    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, 0);
-    if (renderer == nullptr) {
-        std::cout << "SDL could not create renderer! Error: " << SDL_GetError() << std::endl;
+    Display display(displayOptions);
+    if (!display.open(window)) {
         return -1;
     }
+    SDL_Renderer* renderer = display.getRenderer();
+
+    if (stressOptions.enabled) {
+        runStressTest(display, stressOptions);
+    } else {
+        StartMenu startMenu(renderer, display.getWidth(), display.getHeight());
+
+        bool exit = false;
+        bool layoutChanged = false;
+        unsigned int difficulty;
+
+        while (!exit) {
+            SDL_Event event;
+            while (SDL_PollEvent(&event) != 0) {
+                if (event.type == SDL_QUIT) {
+                    exit = true;
+                }
+                if (display.handleEvent(event)) {
+                    layoutChanged = true;
+                }
+                if (event.type == SDL_KEYDOWN) {
+                    display.markInput(event.key.timestamp);
+                }
 
-    StartMenu startMenu(renderer, SCREEN_WIDTH, SCREEN_HEIGHT);
-
-    bool exit = false;
-    unsigned int difficulty;
-    const unsigned int FPS = 60;
-    const float milliSecondsPerFrame = 1000 / FPS;
-    float lastTimeRendered = SDL_GetTicks();
-    float deltaTimeRendered;
-
-    while (!exit) {
-        SDL_Event event;
-        while (SDL_PollEvent(&event) != 0) {
-            if (event.type == SDL_QUIT) {
-                exit = true;
+                int menuAction = startMenu.handleInput(event);
+                if (menuAction == 0) {
+                    difficulty = playMenu(display, &exit);
+                    if (!exit) {
+                        playPuzzle(display, &exit, getBoardOps(difficulty));
+                    }
+                    // The window may have been resized in the meantime.
+                    layoutChanged = true;
+                } else if (menuAction == 2) {
+                    exit = true;
+                }
             }
 
-            int menuAction = startMenu.handleInput(event);
-            if (menuAction == 0) {
-                difficulty = playMenu(renderer, &exit, SCREEN_WIDTH, SCREEN_HEIGHT);
-                if (!exit) {
-                    playPuzzle(renderer, &exit, difficulty, SCREEN_WIDTH, SCREEN_HEIGHT);
-                }
-            } else if (menuAction == 2) {
-                exit = true;
+            if (layoutChanged) {
+                startMenu.layout(display.getWidth(), display.getHeight());
+                layoutChanged = false;
             }
-        }
 
-        deltaTimeRendered = SDL_GetTicks() - lastTimeRendered;
-        if (deltaTimeRendered > milliSecondsPerFrame) {
-            lastTimeRendered = SDL_GetTicks();
+            if (display.beginFrame()) {
 
-            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-            SDL_RenderClear(renderer);
+                SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+                SDL_RenderClear(renderer);
 
-            startMenu.render(renderer);
+                startMenu.render(renderer);
 
-            SDL_RenderPresent(renderer);
-        } else {
-            SDL_Delay(milliSecondsPerFrame - deltaTimeRendered);
+                display.present();
+            }
         }
     }
 
-    SDL_DestroyRenderer(renderer);
+    display.printStats();
+    display.close();
     SDL_DestroyWindow(window);
     renderer = nullptr;
     window = nullptr;
 
     Mix_Quit();
-    TTF_Quit();
+    fonts.close();
     SDL_Quit();
 
     if (gMoveSound) {
@@ -546,9 +505,10 @@ int main( int argc, char* args[] ) {
     if (gVictorySound) {
         Mix_FreeChunk(gVictorySound);
         gVictorySound = nullptr;
-    }
+    }
 
 
-    std::cout << "Exiting program..." << std::endl;
+    LOG_INFO("Exiting program...");
+    gLogger.stop();
     return 0;
 }
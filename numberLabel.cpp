@@ -0,0 +1,60 @@
+#include "numberLabel.h"
+#include <stdio.h>
+
+NumberLabel::NumberLabel(const SDL_Rect& rect, const SDL_Color& colour, const int fontSize, const SDL_Color& fontColour)
+    : UserInterface(rect, colour, fontSize, fontColour),
+      mValue(0) {
+
+}
+
+void NumberLabel::loadGlyphs(SDL_Renderer* const renderer, const char* caption) {
+    loadTexture(renderer, caption);
+
+    const char digits[10][2] = {"0", "1", "2", "3", "4", "5", "6", "7", "8", "9"};
+    for (int i = 0; i < 10; ++i) {
+        mDigits[i] = gTextureCache.acquire(renderer, mFontSize, mFontColour, digits[i]);
+    }
+}
+
+void NumberLabel::setLayout(SDL_Renderer* const renderer, const SDL_Rect& rect, const int fontSize) {
+    const bool resized = fontSize != mFontSize;
+    UserInterface::setLayout(renderer, rect, fontSize);
+    if (resized) {
+        loadGlyphs(renderer, mText.c_str());
+    }
+}
+
+void NumberLabel::setValue(const int value) {
+    mValue = value;
+}
+
+void NumberLabel::render(SDL_Renderer* const renderer) const {
+    SDL_SetRenderDrawColor(renderer, mColour.r, mColour.g, mColour.b, mColour.a);
+    SDL_RenderFillRect(renderer, &mRect);
+
+    char text[16];
+    snprintf(text, sizeof(text), "%d", (mValue < 0) ? 0 : mValue);
+
+    int width = mFontRect.w;
+    for (const char* digit = text; *digit != '\0'; ++digit) {
+        width += mDigits[*digit - '0'].getWidth();
+    }
+
+    SDL_Rect glyphRect = {mRect.x + (mRect.w - width) / 2, 0, mFontRect.w, mFontRect.h};
+    glyphRect.y = mRect.y + (mRect.h - glyphRect.h) / 2;
+    if (mTexture.get() != nullptr) {
+        SDL_RenderCopy(renderer, mTexture.get(), nullptr, &glyphRect);
+    }
+    glyphRect.x += glyphRect.w;
+
+    for (const char* digit = text; *digit != '\0'; ++digit) {
+        const TextureHandle& glyph = mDigits[*digit - '0'];
+        glyphRect.w = glyph.getWidth();
+        glyphRect.h = glyph.getHeight();
+        glyphRect.y = mRect.y + (mRect.h - glyphRect.h) / 2;
+        if (glyph.get() != nullptr) {
+            SDL_RenderCopy(renderer, glyph.get(), nullptr, &glyphRect);
+        }
+        glyphRect.x += glyphRect.w;
+    }
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include "userInterface.h"
+
+// Caption followed by a number. The caption and the ten digit glyphs are
+// rasterized once, so changing the number never creates a texture.
+class NumberLabel : public UserInterface {
+    private:
+        TextureHandle mDigits[10];
+        int mValue;
+
+    public:
+        NumberLabel(const SDL_Rect& rect, const SDL_Color& colour, const int fontSize, const SDL_Color& fontColour);
+
+        void loadGlyphs(SDL_Renderer* const renderer, const char* caption);
+        void setLayout(SDL_Renderer* const renderer, const SDL_Rect& rect, const int fontSize);
+        void setValue(const int value);
+        void render(SDL_Renderer* const renderer) const;
+
+};
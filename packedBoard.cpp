@@ -0,0 +1,127 @@
+#include "packedBoard.h"
+#include "boardKernels.h"
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+bool isSolvedPacked4(const unsigned char* cells, const int) {
+#if defined(__SSE2__)
+    const __m128i goal = _mm_setr_epi8(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16);
+    const __m128i board = _mm_loadu_si128((const __m128i*)cells);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(board, goal)) == 0xFFFF;
+#else
+    return BoardKernel<4>::isSolved(cells, 4);
+#endif
+}
+
+int manhattanPacked4(const unsigned char* cells, const int) {
+#if defined(__SSSE3__)
+    // Goal row and column for numbers 1..15, indexed by the number itself.
+    // The blank (16) wraps to index 0 and is masked out afterwards.
+    const __m128i goalRows = _mm_setr_epi8(0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3);
+    const __m128i goalCols = _mm_setr_epi8(0, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2);
+    const __m128i rows = _mm_setr_epi8(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3);
+    const __m128i cols = _mm_setr_epi8(0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3);
+
+    const __m128i board = _mm_loadu_si128((const __m128i*)cells);
+    const __m128i index = _mm_and_si128(board, _mm_set1_epi8(0x0F));
+    const __m128i targetRows = _mm_shuffle_epi8(goalRows, index);
+    const __m128i targetCols = _mm_shuffle_epi8(goalCols, index);
+
+    const __m128i rowDistance = _mm_or_si128(_mm_subs_epu8(targetRows, rows), _mm_subs_epu8(rows, targetRows));
+    const __m128i colDistance = _mm_or_si128(_mm_subs_epu8(targetCols, cols), _mm_subs_epu8(cols, targetCols));
+    const __m128i blank = _mm_cmpeq_epi8(board, _mm_set1_epi8(16));
+    const __m128i distance = _mm_andnot_si128(blank, _mm_add_epi8(rowDistance, colDistance));
+
+    const __m128i sums = _mm_sad_epu8(distance, _mm_setzero_si128());
+    return _mm_cvtsi128_si32(sums) + _mm_extract_epi16(sums, 4);
+#else
+    return BoardKernel<4>::manhattan(cells, 4);
+#endif
+}
+
+bool isSolvedPacked5(const unsigned char* cells, const int) {
+#if defined(__AVX2__)
+    const __m256i goal = _mm256_setr_epi8(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16,
+                                          17, 18, 19, 20, 21, 22, 23, 24, 25, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i board = _mm256_loadu_si256((const __m256i*)cells);
+    return _mm256_movemask_epi8(_mm256_cmpeq_epi8(board, goal)) == -1;
+#elif defined(__SSE2__)
+    const __m128i goalLow = _mm_setr_epi8(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16);
+    const __m128i goalHigh = _mm_setr_epi8(17, 18, 19, 20, 21, 22, 23, 24, 25, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i low = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)cells), goalLow);
+    const __m128i high = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(cells + 16)), goalHigh);
+    return _mm_movemask_epi8(_mm_and_si128(low, high)) == 0xFFFF;
+#else
+    return BoardKernel<5>::isSolved(cells, 5);
+#endif
+}
+
+int manhattanPacked5(const unsigned char* cells, const int) {
+#if defined(__AVX2__)
+    // Numbers 0..15 and 16..31 are looked up in two tables and blended. The
+    // blank (25) and the zero padding past cell 24 are masked out.
+    const __m256i goalRowsLow = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2,
+                                                 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2);
+    const __m256i goalRowsHigh = _mm256_setr_epi8(3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 0, 0, 0, 0, 0, 0,
+                                                  3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 0, 0, 0, 0, 0, 0);
+    const __m256i goalColsLow = _mm256_setr_epi8(0, 0, 1, 2, 3, 4, 0, 1, 2, 3, 4, 0, 1, 2, 3, 4,
+                                                 0, 0, 1, 2, 3, 4, 0, 1, 2, 3, 4, 0, 1, 2, 3, 4);
+    const __m256i goalColsHigh = _mm256_setr_epi8(0, 1, 2, 3, 4, 0, 1, 2, 3, 4, 0, 0, 0, 0, 0, 0,
+                                                  0, 1, 2, 3, 4, 0, 1, 2, 3, 4, 0, 0, 0, 0, 0, 0);
+    const __m256i rows = _mm256_setr_epi8(0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 3,
+                                          3, 3, 3, 3, 4, 4, 4, 4, 4, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i cols = _mm256_setr_epi8(0, 1, 2, 3, 4, 0, 1, 2, 3, 4, 0, 1, 2, 3, 4, 0,
+                                          1, 2, 3, 4, 0, 1, 2, 3, 4, 0, 0, 0, 0, 0, 0, 0);
+
+    const __m256i board = _mm256_loadu_si256((const __m256i*)cells);
+    const __m256i index = _mm256_and_si256(board, _mm256_set1_epi8(0x0F));
+    const __m256i high = _mm256_cmpgt_epi8(board, _mm256_set1_epi8(15));
+    const __m256i targetRows = _mm256_blendv_epi8(_mm256_shuffle_epi8(goalRowsLow, index), _mm256_shuffle_epi8(goalRowsHigh, index), high);
+    const __m256i targetCols = _mm256_blendv_epi8(_mm256_shuffle_epi8(goalColsLow, index), _mm256_shuffle_epi8(goalColsHigh, index), high);
+
+    const __m256i rowDistance = _mm256_or_si256(_mm256_subs_epu8(targetRows, rows), _mm256_subs_epu8(rows, targetRows));
+    const __m256i colDistance = _mm256_or_si256(_mm256_subs_epu8(targetCols, cols), _mm256_subs_epu8(cols, targetCols));
+    const __m256i ignored = _mm256_or_si256(_mm256_cmpeq_epi8(board, _mm256_set1_epi8(25)), _mm256_cmpeq_epi8(board, _mm256_setzero_si256()));
+    const __m256i distance = _mm256_andnot_si256(ignored, _mm256_add_epi8(rowDistance, colDistance));
+
+    const __m256i sums = _mm256_sad_epu8(distance, _mm256_setzero_si256());
+    const __m128i halves = _mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+    return _mm_cvtsi128_si32(halves) + _mm_extract_epi16(halves, 4);
+#else
+    return BoardKernel<5>::manhattan(cells, 5);
+#endif
+}
+
+static inline uint64_t mix(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDULL;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+// Hashes the board eight cells at a time. Zero padding makes the result
+// depend only on the first size * size cells.
+uint64_t hashPacked(const unsigned char* cells, const int size) {
+    const int words = (size * size + 7) / 8;
+    uint64_t hash = size;
+    for (int i = 0; i < words; ++i) {
+        uint64_t word;
+        memcpy(&word, cells + i * 8, sizeof(word));
+        if (i == words - 1 && (size * size) % 8 != 0) {
+            word &= (1ULL << ((size * size) % 8 * 8)) - 1;
+        }
+        hash = mix(hash ^ (word * 0x9E3779B97F4A7C15ULL));
+    }
+    return hash;
+}
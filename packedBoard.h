@@ -0,0 +1,16 @@
+#pragma once
+#include <stdint.h>
+
+// Packed board kernels: a 4x4 board is one 16-byte SSE register and a 5x5
+// board one 32-byte AVX2 register. The cells array must hold at least
+// BOARD_MAX_CELLS bytes with everything past the last cell set to zero.
+// Paths are picked at compile time (-mssse3, -mavx2) and fall back to the
+// scalar kernels otherwise.
+
+bool isSolvedPacked4(const unsigned char* cells, const int size);
+int manhattanPacked4(const unsigned char* cells, const int size);
+
+bool isSolvedPacked5(const unsigned char* cells, const int size);
+int manhattanPacked5(const unsigned char* cells, const int size);
+
+uint64_t hashPacked(const unsigned char* cells, const int size);
@@ -0,0 +1,41 @@
+#pragma once
+#include <assert.h>
+#include <stddef.h>
+#include <utility>
+#include <vector>
+
+// Contiguous storage with a capacity fixed at construction. Elements are
+// constructed in place and never relocated, so pointers into the pool stay
+// valid for its whole lifetime.
+template <typename T>
+class Pool {
+    private:
+        std::vector<T> mItems;
+
+    public:
+        explicit Pool(const size_t capacity) {
+            mItems.reserve(capacity);
+        }
+
+        Pool(const Pool&) = delete;
+        Pool& operator=(const Pool&) = delete;
+
+        template <typename... Args>
+        T& emplace(Args&&... args) {
+            assert(mItems.size() < mItems.capacity());
+            mItems.emplace_back(std::forward<Args>(args)...);
+            return mItems.back();
+        }
+
+        T& operator[](const size_t index) { return mItems[index]; }
+        const T& operator[](const size_t index) const { return mItems[index]; }
+
+        size_t size() const { return mItems.size(); }
+        size_t capacity() const { return mItems.capacity(); }
+
+        T* begin() { return mItems.data(); }
+        T* end() { return mItems.data() + mItems.size(); }
+        const T* begin() const { return mItems.data(); }
+        const T* end() const { return mItems.data() + mItems.size(); }
+
+};
@@ -0,0 +1,278 @@
+// Headless batch analysis of puzzle boards, built separately from the game:
+//   g++ -std=c++14 -O2 -mavx2 -pthread puzzleAnalyzer.cpp solver.cpp boardKernels.cpp packedBoard.cpp -o puzzleAnalyzer
+//
+// Boards come either from a file or stdin, one per line as N*N numbers with 0
+// or N*N for the blank, or from a range of scramble seeds (the same seeds the
+// game stores in its snapshots). Results are streamed as tab-separated lines
+// in completion order.
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "boardKernels.h"
+#include "solver.h"
+
+const size_t ARENA_CAPACITY = 1 << 20;
+
+struct Options {
+    const char* inputPath;
+    bool seeded;
+    unsigned int firstSeed;
+    unsigned int lastSeed;
+    unsigned int size;
+    unsigned int swaps;
+    unsigned int threads;
+    unsigned long long nodeLimit;
+    bool evaluateOnly;
+};
+
+struct BoardSet {
+    std::vector<unsigned char> cells;
+    std::vector<int> sizes;
+
+    size_t count() const { return sizes.size(); }
+    const unsigned char* at(const size_t i) const { return &cells[i * BOARD_MAX_CELLS]; }
+};
+
+static void printUsage(const char* program) {
+    fprintf(stderr,
+        "Usage: %s [options]\n"
+        "  --input FILE        read boards from FILE instead of stdin\n"
+        "  --seeds FIRST-LAST  analyse the boards scrambled from these seeds\n"
+        "  --size N            board size for --seeds (default 4)\n"
+        "  --swaps K           scramble length for --seeds (default 1000)\n"
+        "  --threads T         worker threads (default: all cores)\n"
+        "  --node-limit L      give up on a board after L expanded nodes\n"
+        "  --evaluate          only report heuristics, do not search\n",
+        program);
+}
+
+// Whole-string decimal in [min, max]; trailing text or overflow is an error.
+static bool parseNumber(const char* text, const long min, const long max, long& value) {
+    char* end = nullptr;
+    errno = 0;
+    const long parsed = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || errno == ERANGE || parsed < min || parsed > max) {
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+static bool parseOptions(int argc, char* args[], Options& options) {
+    options = {nullptr, false, 0, 0, 4, 1000, std::thread::hardware_concurrency(), 0, false};
+    if (options.threads == 0) {
+        options.threads = 1;
+    }
+
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (strcmp(args[i], "--input") == 0 && hasValue) {
+            options.inputPath = args[++i];
+        } else if (strcmp(args[i], "--seeds") == 0 && hasValue) {
+            if (sscanf(args[++i], "%u-%u", &options.firstSeed, &options.lastSeed) != 2 || options.lastSeed < options.firstSeed) {
+                return false;
+            }
+            options.seeded = true;
+        } else if (strcmp(args[i], "--size") == 0 && hasValue) {
+            long size = 0;
+            if (!parseNumber(args[++i], 2, BOARD_MAX_SIZE, size)) {
+                return false;
+            }
+            options.size = size;
+        } else if (strcmp(args[i], "--swaps") == 0 && hasValue) {
+            long swaps = 0;
+            if (!parseNumber(args[++i], 0, INT_MAX, swaps)) {
+                return false;
+            }
+            options.swaps = swaps;
+        } else if (strcmp(args[i], "--threads") == 0 && hasValue) {
+            long threads = 0;
+            if (!parseNumber(args[++i], 1, 1024, threads)) {
+                return false;
+            }
+            options.threads = threads;
+        } else if (strcmp(args[i], "--node-limit") == 0 && hasValue) {
+            // strtoull accepts a sign and wraps negative values around.
+            const char* text = args[++i];
+            char* end = nullptr;
+            errno = 0;
+            options.nodeLimit = strtoull(text, &end, 10);
+            if (strchr(text, '-') != nullptr || end == text || *end != '\0' || errno == ERANGE) {
+                return false;
+            }
+        } else if (strcmp(args[i], "--evaluate") == 0) {
+            options.evaluateOnly = true;
+        } else {
+            return false;
+        }
+    }
+
+    return options.size >= 2 && options.size <= BOARD_MAX_SIZE;
+}
+
+// Parses one board per line. The size is taken from the number of values,
+// which has to be a perfect square.
+static bool readBoards(FILE* input, BoardSet& boards) {
+    char line[1024];
+    int lineNumber = 0;
+    while (fgets(line, sizeof(line), input) != nullptr) {
+        ++lineNumber;
+        if (strchr(line, '\n') == nullptr && !feof(input)) {
+            fprintf(stderr, "Line %d: too long\n", lineNumber);
+            return false;
+        }
+        int values[BOARD_MAX_CELLS + 1];
+        int count = 0;
+        for (char* token = strtok(line, " \t,\r\n"); token != nullptr; token = strtok(nullptr, " \t,\r\n")) {
+            if (token[0] == '#' || count > BOARD_MAX_CELLS) {
+                break;
+            }
+            values[count++] = atoi(token);
+        }
+        if (count == 0) {
+            continue;
+        }
+
+        const int size = (int)lround(sqrt((double)count));
+        if (size < 2 || size * size != count) {
+            fprintf(stderr, "Line %d: expected N*N values, got %d\n", lineNumber, count);
+            return false;
+        }
+
+        const size_t offset = boards.cells.size();
+        boards.cells.resize(offset + BOARD_MAX_CELLS, 0);
+        unsigned char* cells = &boards.cells[offset];
+        bool seen[BOARD_MAX_CELLS + 1] = {false};
+        for (int i = 0; i < count; ++i) {
+            const int number = (values[i] == 0) ? count : values[i];
+            if (number < 1 || number > count || seen[number]) {
+                fprintf(stderr, "Line %d: value %d out of range or repeated\n", lineNumber, values[i]);
+                return false;
+            }
+            cells[i] = number;
+            seen[number] = true;
+        }
+        boards.sizes.push_back(size);
+    }
+    return true;
+}
+
+static void generateBoards(const Options& options, BoardSet& boards) {
+    const BoardOps ops = getBoardOps(options.size);
+    const size_t count = (size_t)options.lastSeed - options.firstSeed + 1;
+    boards.cells.assign(count * BOARD_MAX_CELLS, 0);
+    boards.sizes.assign(count, options.size);
+
+    // scrambleBoard() goes through rand(), so boards are generated up front on
+    // this thread and the workers only ever read them.
+    for (size_t i = 0; i < count; ++i) {
+        scrambleBoard(ops, &boards.cells[i * BOARD_MAX_CELLS], options.firstSeed + i, options.swaps);
+    }
+}
+
+static const char* statusName(const SolveStatus status) {
+    switch (status) {
+        case SOLVE_FOUND:
+            return "solved";
+        case SOLVE_UNSOLVABLE:
+            return "unsolvable";
+        case SOLVE_UNSUPPORTED_SIZE:
+            return "unsupported";
+        case SOLVE_NODE_LIMIT:
+            return "node-limit";
+        case SOLVE_OUT_OF_MEMORY:
+            return "out-of-memory";
+    }
+    return "unknown";
+}
+
+static void analyseBoards(const Options& options, const BoardSet& boards, std::atomic<size_t>& next, std::mutex& outputMutex) {
+    ScratchArena arena(ARENA_CAPACITY);
+    char line[160];
+
+    for (size_t i = next++; i < boards.count(); i = next++) {
+        const unsigned char* cells = boards.at(i);
+        const int size = boards.sizes[i];
+        const size_t label = options.seeded ? options.firstSeed + i : i + 1;
+
+        if (options.evaluateOnly) {
+            const BoardOps ops = getBoardOps(size);
+            snprintf(line, sizeof(line), "%zu\t%d\t%d\t%d\t%s\n", label, size,
+                ops.manhattan(cells, size), linearConflict(cells, size), isSolvable(cells, size) ? "yes" : "no");
+        } else {
+            arena.reset();
+            const auto start = std::chrono::steady_clock::now();
+            const SolveResult result = solveOptimal(cells, size, arena, options.nodeLimit);
+            const double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            if (result.status == SOLVE_FOUND) {
+                snprintf(line, sizeof(line), "%zu\t%d\t%s\t%d\t%llu\t%.3f\n", label, size, statusName(result.status), result.length, result.nodes, milliseconds);
+            } else {
+                snprintf(line, sizeof(line), "%zu\t%d\t%s\t-\t%llu\t%.3f\n", label, size, statusName(result.status), result.nodes, milliseconds);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(outputMutex);
+        fputs(line, stdout);
+    }
+}
+
+int main(int argc, char* args[]) {
+    Options options;
+    if (!parseOptions(argc, args, options)) {
+        printUsage(args[0]);
+        return 1;
+    }
+
+    // Rows are streamed as boards finish, also when stdout is a pipe.
+    setvbuf(stdout, nullptr, _IOLBF, 0);
+
+    BoardSet boards;
+    if (options.seeded) {
+        generateBoards(options, boards);
+    } else {
+        FILE* input = (options.inputPath != nullptr) ? fopen(options.inputPath, "r") : stdin;
+        if (input == nullptr) {
+            fprintf(stderr, "Unable to open %s\n", options.inputPath);
+            return 1;
+        }
+        const bool read = readBoards(input, boards);
+        if (input != stdin) {
+            fclose(input);
+        }
+        if (!read) {
+            return 1;
+        }
+    }
+
+    if (options.evaluateOnly) {
+        puts("board\tsize\tmanhattan\tconflicts\tsolvable");
+    } else {
+        puts("board\tsize\tstatus\tlength\tnodes\tms");
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    std::atomic<size_t> next(0);
+    std::mutex outputMutex;
+    std::vector<std::thread> workers;
+    for (unsigned int i = 0; i < options.threads; ++i) {
+        workers.emplace_back(analyseBoards, std::cref(options), std::cref(boards), std::ref(next), std::ref(outputMutex));
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    fprintf(stderr, "%zu boards on %u threads in %.3f s (%.1f boards/s)\n",
+        boards.count(), options.threads, seconds, boards.count() / seconds);
+    return 0;
+}
@@ -0,0 +1,104 @@
+#include "puzzleBoard.h"
+#include <algorithm>
+#include <string.h>
+
+PuzzleBoard::PuzzleBoard(const BoardOps& ops, const float horizontalMoveTicks, const float verticalMoveTicks)
+    : mOps(ops), mEmptyIndex(0), mMovingIndex(-1), mProgress(0),
+      mHorizontalMoveTicks(horizontalMoveTicks), mVerticalMoveTicks(verticalMoveTicks), mMoveCount(0) {
+    memset(mCells, 0, sizeof(mCells));
+}
+
+void PuzzleBoard::scramble(const unsigned int seed, const unsigned int swaps) {
+    mEmptyIndex = scrambleBoard(mOps, mCells, seed, swaps);
+    mMovingIndex = -1;
+    mProgress = 0;
+    mMoveCount = 0;
+    mEstimate.reset(mCells, mOps.size);
+}
+
+void PuzzleBoard::restore(const unsigned char* cells, const int emptyIndex, const unsigned int moveCount) {
+    std::copy(cells, cells + mOps.size * mOps.size, mCells);
+    mEmptyIndex = emptyIndex;
+    mMovingIndex = -1;
+    mProgress = 0;
+    mMoveCount = moveCount;
+    mEstimate.reset(mCells, mOps.size);
+}
+
+bool PuzzleBoard::isNeighbourOfBlank(const int cell) const {
+    int moves[4];
+    const int count = mOps.generateMoves(mEmptyIndex, moves, mOps.size);
+
+    for (int i = 0; i < count; ++i) {
+        if (moves[i] == cell) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool PuzzleBoard::startMove(const int cell) {
+    if (mMovingIndex != -1 || !isNeighbourOfBlank(cell)) {
+        return false;
+    }
+    mMovingIndex = cell;
+    mProgress = 0;
+    return true;
+}
+
+bool PuzzleBoard::tick() {
+    if (mMovingIndex == -1) {
+        return false;
+    }
+
+    const bool horizontal = mMovingIndex / mOps.size == mEmptyIndex / mOps.size;
+    mProgress += 1 / (horizontal ? mHorizontalMoveTicks : mVerticalMoveTicks);
+    if (mProgress < 1) {
+        return false;
+    }
+
+    std::swap(mCells[mMovingIndex], mCells[mEmptyIndex]);
+    mEstimate.update(mCells, mMovingIndex, mEmptyIndex);
+    mEmptyIndex = mMovingIndex;
+    mMovingIndex = -1;
+    mProgress = 0;
+    ++mMoveCount;
+    return true;
+}
+
+bool PuzzleBoard::isMoving() const {
+    return mMovingIndex != -1;
+}
+
+bool PuzzleBoard::isSolved() const {
+    return mOps.isSolved(mCells, mOps.size);
+}
+
+const BoardOps& PuzzleBoard::getOps() const {
+    return mOps;
+}
+
+const unsigned char* PuzzleBoard::getCells() const {
+    return mCells;
+}
+
+int PuzzleBoard::getEmptyIndex() const {
+    return mEmptyIndex;
+}
+
+int PuzzleBoard::getMovingIndex() const {
+    return mMovingIndex;
+}
+
+float PuzzleBoard::getProgress() const {
+    return mProgress;
+}
+
+unsigned int PuzzleBoard::getMoveCount() const {
+    return mMoveCount;
+}
+
+int PuzzleBoard::getEstimate() const {
+    return mEstimate.get();
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include "boardKernels.h"
+#include "solver.h"
+
+// The board of one game and the tile sliding across it, advanced one tick at
+// a time. Knows nothing about threads, timers or rendering, so the game and
+// the stress test drive it the same way.
+class PuzzleBoard {
+    private:
+        BoardOps mOps;
+        unsigned char mCells[BOARD_MAX_CELLS];
+        int mEmptyIndex;
+        int mMovingIndex;
+        float mProgress;
+        float mHorizontalMoveTicks;
+        float mVerticalMoveTicks;
+        unsigned int mMoveCount;
+        DistanceEstimate mEstimate;
+
+    public:
+        // Move durations are given in ticks per cell travelled.
+        PuzzleBoard(const BoardOps& ops, const float horizontalMoveTicks, const float verticalMoveTicks);
+
+        void scramble(const unsigned int seed, const unsigned int swaps);
+        void restore(const unsigned char* cells, const int emptyIndex, const unsigned int moveCount);
+
+        bool isNeighbourOfBlank(const int cell) const;
+        // Starts sliding the tile at cell into the blank; refused while
+        // another tile is moving or if the tile is not next to the blank.
+        bool startMove(const int cell);
+        // Returns true on the tick the moving tile lands.
+        bool tick();
+
+        bool isMoving() const;
+        bool isSolved() const;
+
+        const BoardOps& getOps() const;
+        const unsigned char* getCells() const;
+        int getEmptyIndex() const;
+        int getMovingIndex() const;
+        float getProgress() const;
+        unsigned int getMoveCount() const;
+        int getEstimate() const;
+
+};
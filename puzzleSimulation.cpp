@@ -0,0 +1,199 @@
+#include "puzzleSimulation.h"
+#include <algorithm>
+#include <chrono>
+#include <string.h>
+#include "snapshot.h"
+
+static const char* const SNAPSHOT_PATH = "savegame.dat";
+static const unsigned int TOTAL_SWAPS = 1000;
+static const double SOLVER_BUDGET_MS = 2;
+
+PuzzleSimulation::PuzzleSimulation(const BoardOps& ops, const float horizontalMoveMs, const float verticalMoveMs)
+    : mBoard(ops, horizontalMoveMs * TICK_RATE / 1000, verticalMoveMs * TICK_RATE / 1000),
+      mSeed(0), mTick(0), mSolved(false), mPaused(false), mRunning(false),
+      mAutoplaying(false), mAutoplayMove(0), mInputsPosted(0), mInputsHandled(0) {
+    GameSnapshot snapshot;
+    if (loadSnapshot(SNAPSHOT_PATH, snapshot) && snapshot.difficulty == ops.size) {
+        mBoard.restore(snapshot.cells, snapshot.blankIndex, snapshot.moveCount);
+        mSeed = snapshot.seed;
+        mTimer.restore(snapshot.elapsedTime, snapshot.totalPausedTime);
+    } else {
+        newGame();
+    }
+
+    publish();
+}
+
+void PuzzleSimulation::newGame() {
+    // The tick keeps two new games within the same second apart.
+    mSeed = time(NULL) + mTick;
+    mBoard.scramble(mSeed, TOTAL_SWAPS);
+    mTimer.start();
+    mSolved = false;
+    if (mAutoplaying) {
+        mAutoplaying = false;
+        mAutoplay.cancel();
+    }
+}
+
+PuzzleSimulation::~PuzzleSimulation() {
+    stop();
+}
+
+void PuzzleSimulation::start() {
+    mRunning = true;
+    mThread = std::thread(&PuzzleSimulation::run, this);
+}
+
+void PuzzleSimulation::stop() {
+    if (mThread.joinable()) {
+        while (post({INPUT_QUIT, 0}) == 0) {
+            std::this_thread::yield();
+        }
+        mThread.join();
+    }
+}
+
+unsigned int PuzzleSimulation::post(const PuzzleInput& input) {
+    if (!mInputs.push(input)) {
+        return 0;
+    }
+    return ++mInputsPosted;
+}
+
+bool PuzzleSimulation::updateFrame() {
+    return mFrames.update();
+}
+
+const PuzzleFrame& PuzzleSimulation::getFrame() const {
+    return mFrames.readBuffer();
+}
+
+void PuzzleSimulation::run() {
+    const std::chrono::nanoseconds tickLength(1000000000 / TICK_RATE);
+    auto nextTick = std::chrono::steady_clock::now();
+
+    while (mRunning) {
+        PuzzleInput input;
+        while (mRunning && mInputs.pop(input)) {
+            handleInput(input);
+            ++mInputsHandled;
+        }
+        if (!mRunning) {
+            break;
+        }
+
+        update();
+        publish();
+
+        nextTick += tickLength;
+        std::this_thread::sleep_until(nextTick);
+    }
+}
+
+void PuzzleSimulation::handleInput(const PuzzleInput& input) {
+    switch (input.type) {
+        case INPUT_CLICK_TILE:
+            if (!mPaused && !mSolved && mBoard.startMove(input.cell) && mAutoplaying) {
+                mAutoplaying = false;
+                mAutoplay.cancel();
+            }
+            break;
+
+        case INPUT_TOGGLE_PAUSE:
+            mPaused = !mPaused;
+            if (!mSolved) {
+                if (mPaused) {
+                    mTimer.pause();
+                    save();
+                } else {
+                    mTimer.resume();
+                }
+            }
+            break;
+
+        case INPUT_TOGGLE_AUTOPLAY:
+            if (!mSolved && !mPaused && !mBoard.isMoving()) {
+                mAutoplaying = !mAutoplaying;
+                if (mAutoplaying) {
+                    mAutoplay.begin(mBoard.getCells(), mBoard.getOps().size);
+                    mAutoplayMove = 0;
+                } else {
+                    mAutoplay.cancel();
+                }
+            }
+            break;
+
+        case INPUT_NEW_GAME:
+            if (!mPaused) {
+                newGame();
+                removeSnapshot(SNAPSHOT_PATH);
+            }
+            break;
+
+        case INPUT_QUIT:
+            if (!mSolved) {
+                save();
+            }
+            mRunning = false;
+            break;
+    }
+}
+
+void PuzzleSimulation::update() {
+    ++mTick;
+    if (mPaused) {
+        return;
+    }
+
+    if (mAutoplaying) {
+        mAutoplay.step(SOLVER_BUDGET_MS);
+        const std::vector<int>& moves = mAutoplay.getMoves();
+        if (mAutoplay.hasFailed() || (mAutoplay.isDone() && mAutoplayMove == moves.size())) {
+            mAutoplaying = false;
+        } else if (!mBoard.isMoving() && mAutoplayMove < moves.size()) {
+            if (!mBoard.startMove(moves[mAutoplayMove++])) {
+                mAutoplaying = false;
+                mAutoplay.cancel();
+            }
+        }
+    }
+
+    if (mBoard.tick()) {
+        mSolved = mBoard.isSolved();
+        if (mSolved) {
+            mTimer.pause();
+            removeSnapshot(SNAPSHOT_PATH);
+        }
+    }
+}
+
+void PuzzleSimulation::publish() {
+    PuzzleFrame& frame = mFrames.writeBuffer();
+    memcpy(frame.cells, mBoard.getCells(), sizeof(frame.cells));
+    frame.emptyIndex = mBoard.getEmptyIndex();
+    frame.movingIndex = mBoard.getMovingIndex();
+    frame.progress = mBoard.getProgress();
+    frame.elapsedTime = mTimer.getElapsedTime();
+    frame.estimate = mBoard.getEstimate();
+    frame.moveCount = mBoard.getMoveCount();
+    frame.tick = mTick;
+    frame.inputsHandled = mInputsHandled;
+    frame.solved = mSolved;
+    frame.paused = mPaused;
+    mFrames.publish();
+}
+
+void PuzzleSimulation::save() {
+    GameSnapshot snapshot = {};
+    const unsigned int size = mBoard.getOps().size;
+    snapshot.difficulty = size;
+    snapshot.blankIndex = mBoard.getEmptyIndex();
+    snapshot.moveCount = mBoard.getMoveCount();
+    snapshot.seed = mSeed;
+    snapshot.elapsedTime = mTimer.getElapsedTime();
+    snapshot.totalPausedTime = mTimer.getTotalPausedTime();
+    std::copy(mBoard.getCells(), mBoard.getCells() + size * size, snapshot.cells);
+
+    saveSnapshot(SNAPSHOT_PATH, snapshot);
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <time.h>
+#include <atomic>
+#include <thread>
+#include "boardKernels.h"
+#include "puzzleBoard.h"
+#include "realtimeSolver.h"
+#include "spscQueue.h"
+#include "timer.h"
+#include "tripleBuffer.h"
+
+enum PuzzleInputType {
+    INPUT_CLICK_TILE,
+    INPUT_TOGGLE_PAUSE,
+    INPUT_TOGGLE_AUTOPLAY,
+    INPUT_NEW_GAME,
+    INPUT_QUIT
+};
+
+struct PuzzleInput {
+    PuzzleInputType type;
+    int cell;
+};
+
+// Immutable view of the game handed from the simulation to the renderer.
+// The tile at movingIndex is progress of the way into emptyIndex.
+struct PuzzleFrame {
+    unsigned char cells[BOARD_MAX_CELLS];
+    int emptyIndex;
+    int movingIndex;
+    float progress;
+    time_t elapsedTime;
+    int estimate;
+    unsigned int moveCount;
+    unsigned int tick;
+    unsigned int inputsHandled; // inputs posted so far that this frame reflects
+    bool solved;
+    bool paused;
+};
+
+// Board moves, tile animation, the game timer, autoplay and snapshots, run on
+// their own thread at a fixed tick rate. Input arrives through an SPSC queue
+// and every tick publishes a PuzzleFrame through a triple buffer, so neither
+// side ever blocks on the other.
+class PuzzleSimulation {
+    private:
+        static const unsigned int TICK_RATE = 120;
+
+        PuzzleBoard mBoard;
+        unsigned int mSeed;
+        unsigned int mTick;
+        bool mSolved;
+        bool mPaused;
+        bool mRunning;
+
+        Timer mTimer;
+        RealtimeSolver mAutoplay;
+        bool mAutoplaying;
+        size_t mAutoplayMove;
+
+        SpscQueue<PuzzleInput, 256> mInputs;
+        unsigned int mInputsPosted;     // render thread
+        unsigned int mInputsHandled;    // simulation thread
+        TripleBuffer<PuzzleFrame> mFrames;
+        std::thread mThread;
+
+        void newGame();
+        void run();
+        void handleInput(const PuzzleInput& input);
+        void update();
+        void publish();
+        void save();
+
+    public:
+        // Move durations are given in milliseconds per cell travelled.
+        PuzzleSimulation(const BoardOps& ops, const float horizontalMoveMs, const float verticalMoveMs);
+        ~PuzzleSimulation();
+
+        PuzzleSimulation(const PuzzleSimulation&) = delete;
+        PuzzleSimulation& operator=(const PuzzleSimulation&) = delete;
+
+        void start();
+        // Asks the simulation to save and finish, then waits for its thread.
+        void stop();
+
+        // Render thread only. Returns the input's sequence number, counted
+        // from 1 in the order inputs were queued, for matching it to the
+        // frame that shows it, or 0 when the queue is full.
+        unsigned int post(const PuzzleInput& input);
+        bool updateFrame();
+        const PuzzleFrame& getFrame() const;
+
+};
@@ -0,0 +1,216 @@
+#include "realtimeSolver.h"
+#include <chrono>
+#include <string.h>
+#include <algorithm>
+
+RealtimeSolver::RealtimeSolver()
+    : mSize(0), mBlank(0), mNextTask(0), mDone(false), mFailed(false),
+      mSearching(false), mTask(), mFreeCount(0), mQueueHead(0), mStamp(0) {
+
+}
+
+void RealtimeSolver::begin(const unsigned char* cells, const int size) {
+    mSize = size;
+    memset(mCells, 0, sizeof(mCells));
+    memcpy(mCells, cells, size * size);
+    memset(mLocked, 0, sizeof(mLocked));
+    for (int i = 0; i < size * size; ++i) {
+        if (mCells[i] == size * size) {
+            mBlank = i;
+        }
+    }
+
+    mMoves.clear();
+    mDone = false;
+    mFailed = false;
+    mSearching = false;
+    mNextTask = 0;
+    planTasks();
+}
+
+void RealtimeSolver::cancel() {
+    mSize = 0;
+    mSearching = false;
+    mMoves.clear();
+}
+
+void RealtimeSolver::planTasks() {
+    const int n = mSize;
+    mTasks.clear();
+
+    for (int row = 0; row < n - 2; ++row) {
+        for (int col = 0; col < n - 2; ++col) {
+            mTasks.push_back({1, {row * n + col + 1, 0, 0}});
+        }
+        mTasks.push_back({2, {row * n + n - 1, row * n + n, 0}});
+    }
+    for (int col = 0; col < n - 2; ++col) {
+        mTasks.push_back({2, {(n - 2) * n + col + 1, (n - 1) * n + col + 1, 0}});
+    }
+    mTasks.push_back({3, {(n - 2) * n + n - 1, (n - 2) * n + n, (n - 1) * n + n - 1}});
+}
+
+// States are the local cell indices of the blank followed by the tracked
+// tiles, packed in base mFreeCount.
+int RealtimeSolver::encode(const int* positions) const {
+    int state = 0;
+    for (int i = mTask.count; i >= 0; --i) {
+        state = state * mFreeCount + positions[i];
+    }
+    return state;
+}
+
+void RealtimeSolver::decode(int state, int* positions) const {
+    for (int i = 0; i <= mTask.count; ++i) {
+        positions[i] = state % mFreeCount;
+        state /= mFreeCount;
+    }
+}
+
+bool RealtimeSolver::isGoal(const int* positions) const {
+    for (int i = 0; i < mTask.count; ++i) {
+        if (positions[i + 1] != mTargets[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void RealtimeSolver::startTask() {
+    mTask = mTasks[mNextTask++];
+
+    mFreeCount = 0;
+    for (int cell = 0; cell < mSize * mSize; ++cell) {
+        mLocalOf[cell] = -1;
+        if (!mLocked[cell]) {
+            mLocalOf[cell] = mFreeCount;
+            mGlobalOf[mFreeCount++] = cell;
+        }
+    }
+    for (int local = 0; local < mFreeCount; ++local) {
+        int moves[4];
+        const int count = generateMovesGeneric(mGlobalOf[local], moves, mSize);
+        mNeighbourCount[local] = 0;
+        for (int i = 0; i < count; ++i) {
+            if (mLocalOf[moves[i]] != -1) {
+                mNeighbours[local][mNeighbourCount[local]++] = mLocalOf[moves[i]];
+            }
+        }
+    }
+
+    int positions[4];
+    positions[0] = mLocalOf[mBlank];
+    for (int i = 0; i < mTask.count; ++i) {
+        const int number = mTask.numbers[i];
+        mTargets[i] = mLocalOf[number - 1];
+        for (int cell = 0; cell < mSize * mSize; ++cell) {
+            if (mCells[cell] == number) {
+                positions[i + 1] = mLocalOf[cell];
+            }
+        }
+    }
+
+    size_t states = 1;
+    for (int i = 0; i <= mTask.count; ++i) {
+        states *= mFreeCount;
+    }
+    if (mVisited.size() < states) {
+        mVisited.assign(states, 0);
+        mParent.resize(states);
+        mStamp = 0;
+    }
+    ++mStamp;
+
+    const int start = encode(positions);
+    mVisited[start] = mStamp;
+    mParent[start] = -1;
+    mQueue.clear();
+    mQueue.push_back(start);
+    mQueueHead = 0;
+    mSearching = true;
+}
+
+void RealtimeSolver::finishTask(int goal) {
+    const size_t first = mMoves.size();
+    int positions[4];
+    for (int state = goal; mParent[state] != -1; state = mParent[state]) {
+        decode(state, positions);
+        mMoves.push_back(mGlobalOf[positions[0]]);
+    }
+    std::reverse(mMoves.begin() + first, mMoves.end());
+
+    for (size_t i = first; i < mMoves.size(); ++i) {
+        const int cell = mMoves[i];
+        mCells[mBlank] = mCells[cell];
+        mCells[cell] = mSize * mSize;
+        mBlank = cell;
+    }
+    for (int i = 0; i < mTask.count; ++i) {
+        mLocked[mTask.numbers[i] - 1] = true;
+    }
+
+    mSearching = false;
+    if (mNextTask == mTasks.size()) {
+        mDone = true;
+    }
+}
+
+bool RealtimeSolver::step(const double budgetMilliseconds) {
+    if (mDone || mFailed || mSize == 0) {
+        return mDone;
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double, std::milli>(budgetMilliseconds);
+    unsigned int expanded = 0;
+
+    while (!mDone) {
+        if (!mSearching) {
+            startTask();
+        }
+
+        int positions[4];
+        bool found = false;
+        while (mQueueHead < mQueue.size()) {
+            const int state = mQueue[mQueueHead++];
+            decode(state, positions);
+            if (isGoal(positions)) {
+                finishTask(state);
+                found = true;
+                break;
+            }
+
+            const int blank = positions[0];
+            for (int i = 0; i < mNeighbourCount[blank]; ++i) {
+                int next[4];
+                memcpy(next, positions, sizeof(next));
+                const int cell = mNeighbours[blank][i];
+                next[0] = cell;
+                for (int tile = 1; tile <= mTask.count; ++tile) {
+                    if (next[tile] == cell) {
+                        next[tile] = blank;
+                    }
+                }
+
+                const int nextState = encode(next);
+                if (mVisited[nextState] != mStamp) {
+                    mVisited[nextState] = mStamp;
+                    mParent[nextState] = state;
+                    mQueue.push_back(nextState);
+                }
+            }
+
+            if ((++expanded & 0xFF) == 0 && std::chrono::steady_clock::now() >= deadline) {
+                return false;
+            }
+        }
+
+        if (!found) {
+            mFailed = true;
+            return false;
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+    }
+    return mDone;
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <stddef.h>
+#include <vector>
+#include "boardKernels.h"
+
+// Sub-optimal solver for boards of any size that works in time slices.
+// It reduces the board the way a player would: rows top to bottom until two
+// are left, then those two rows column by column, then the final 2x2 block.
+// Each placement is a breadth-first search over the positions of the blank
+// and the one to three tiles being placed, with the finished cells locked.
+class RealtimeSolver {
+    private:
+        struct Task {
+            int count;
+            int numbers[3];
+        };
+
+        int mSize;
+        unsigned char mCells[BOARD_MAX_CELLS];
+        int mBlank;
+        bool mLocked[BOARD_MAX_CELLS];
+        std::vector<Task> mTasks;
+        size_t mNextTask;
+        std::vector<int> mMoves;
+        bool mDone;
+        bool mFailed;
+
+        bool mSearching;
+        Task mTask;
+        int mFreeCount;
+        int mLocalOf[BOARD_MAX_CELLS];
+        int mGlobalOf[BOARD_MAX_CELLS];
+        int mNeighbours[BOARD_MAX_CELLS][4];
+        int mNeighbourCount[BOARD_MAX_CELLS];
+        int mTargets[3];
+        std::vector<unsigned int> mVisited;
+        std::vector<int> mParent;
+        std::vector<int> mQueue;
+        size_t mQueueHead;
+        unsigned int mStamp;
+
+        void planTasks();
+        void startTask();
+        bool isGoal(const int* positions) const;
+        void decode(int state, int* positions) const;
+        int encode(const int* positions) const;
+        void finishTask(int goal);
+
+    public:
+        RealtimeSolver();
+
+        void begin(const unsigned char* cells, const int size);
+        // Works for roughly budgetMilliseconds and returns true once the
+        // whole move sequence is known.
+        bool step(const double budgetMilliseconds);
+        void cancel();
+
+        bool isDone() const { return mDone; }
+        bool isRunning() const { return !mDone && !mFailed && mSize != 0; }
+        bool hasFailed() const { return mFailed; }
+        // Cells the blank moves into, in order. Moves are appended as each
+        // placement is found and can be played while the search goes on.
+        const std::vector<int>& getMoves() const { return mMoves; }
+
+};
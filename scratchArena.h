@@ -0,0 +1,32 @@
+#pragma once
+#include <stddef.h>
+#include <vector>
+
+// Bump allocator for per-thread scratch memory. Allocation is a pointer
+// increment and reset() releases everything at once, so workers never touch
+// the shared heap once their arena is set up.
+class ScratchArena {
+    private:
+        std::vector<unsigned char> mBuffer;
+        size_t mUsed;
+
+    public:
+        explicit ScratchArena(const size_t capacity) : mBuffer(capacity), mUsed(0) {}
+
+        ScratchArena(const ScratchArena&) = delete;
+        ScratchArena& operator=(const ScratchArena&) = delete;
+
+        template <typename T>
+        T* allocate(const size_t count) {
+            const size_t start = (mUsed + alignof(T) - 1) & ~(alignof(T) - 1);
+            if (start + count * sizeof(T) > mBuffer.size()) {
+                return nullptr;
+            }
+            mUsed = start + count * sizeof(T);
+            return reinterpret_cast<T*>(mBuffer.data() + start);
+        }
+
+        void reset() { mUsed = 0; }
+        size_t used() const { return mUsed; }
+
+};
@@ -0,0 +1,78 @@
+#include "snapshot.h"
+#include <stdio.h>
+#include "logger.h"
+#include "solver.h"
+
+static const uint32_t SNAPSHOT_MAGIC = 0x50534C53; // "SLSP"
+static const uint32_t SNAPSHOT_VERSION = 1;
+
+static bool isValid(const GameSnapshot& snapshot) {
+    if (snapshot.magic != SNAPSHOT_MAGIC || snapshot.version != SNAPSHOT_VERSION) {
+        return false;
+    }
+
+    const unsigned int size = snapshot.difficulty;
+    if (size < 2 || size * size > SNAPSHOT_MAX_CELLS || snapshot.blankIndex >= size * size) {
+        return false;
+    }
+
+    if (snapshot.cells[snapshot.blankIndex] != size * size) {
+        return false;
+    }
+
+    bool seen[SNAPSHOT_MAX_CELLS + 1] = {false};
+    for (unsigned int i = 0; i < size * size; ++i) {
+        const unsigned int number = snapshot.cells[i];
+        if (number < 1 || number > size * size || seen[number]) {
+            return false;
+        }
+        seen[number] = true;
+    }
+
+    // A scramble only ever reaches boards of the solved board's parity; a
+    // hand-edited or corrupt file could hold one that cannot be solved.
+    if (!isSolvable(snapshot.cells, size)) {
+        return false;
+    }
+
+    return snapshot.elapsedTime >= 0 && snapshot.totalPausedTime >= 0;
+}
+
+bool saveSnapshot(const char* path, GameSnapshot& snapshot) {
+    snapshot.magic = SNAPSHOT_MAGIC;
+    snapshot.version = SNAPSHOT_VERSION;
+
+    FILE* file = fopen(path, "wb");
+    if (file == nullptr) {
+        LOG_ERROR("Unable to open snapshot file for writing: %s", path);
+        return false;
+    }
+
+    const bool written = fwrite(&snapshot, sizeof(GameSnapshot), 1, file) == 1;
+    fclose(file);
+
+    if (!written) {
+        LOG_ERROR("Unable to write snapshot file: %s", path);
+    }
+    return written;
+}
+
+bool loadSnapshot(const char* path, GameSnapshot& snapshot) {
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr) {
+        return false;
+    }
+
+    const bool read = fread(&snapshot, sizeof(GameSnapshot), 1, file) == 1;
+    fclose(file);
+
+    if (!read || !isValid(snapshot)) {
+        LOG_WARNING("Ignoring invalid snapshot file: %s", path);
+        return false;
+    }
+    return true;
+}
+
+void removeSnapshot(const char* path) {
+    remove(path);
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <stdint.h>
+
+const unsigned int SNAPSHOT_MAX_CELLS = 25;
+
+// Fixed-layout record of an in-progress game, written and read with a single
+// call so that resuming never has to replay the scramble.
+struct GameSnapshot {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t difficulty;
+    uint32_t blankIndex;
+    uint32_t moveCount;
+    uint32_t seed;
+    int64_t elapsedTime;
+    int64_t totalPausedTime;
+    uint8_t cells[SNAPSHOT_MAX_CELLS];
+    // Spelled out so no compiler padding is written to disk; kept zero.
+    uint8_t reserved[7];
+};
+
+static_assert(sizeof(GameSnapshot) == 72, "GameSnapshot must keep its on-disk size");
+
+bool saveSnapshot(const char* path, GameSnapshot& snapshot);
+bool loadSnapshot(const char* path, GameSnapshot& snapshot);
+void removeSnapshot(const char* path);
@@ -0,0 +1,287 @@
+#include "solver.h"
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+
+static const int FOUND = -1;
+static const int ABORTED = -2;
+
+bool isSolvable(const unsigned char* cells, const int size) {
+    // Every move swaps the blank with a neighbour, flipping both the
+    // permutation parity and the parity of the blank's distance from home.
+    int inversions = 0;
+    int blank = 0;
+    for (int i = 0; i < size * size; ++i) {
+        if (cells[i] == size * size) {
+            blank = i;
+        }
+        for (int j = i + 1; j < size * size; ++j) {
+            if (cells[j] < cells[i]) {
+                ++inversions;
+            }
+        }
+    }
+    const int blankDistance = (size - 1 - blank / size) + (size - 1 - blank % size);
+    return (inversions % 2) == (blankDistance % 2);
+}
+
+// Number of tiles that have to leave a line so the remaining tiles that
+// belong to it are in goal order: line length minus the longest increasing
+// run of goal positions.
+static int lineConflicts(const int* goals, const int count) {
+    int longest[BOARD_MAX_SIZE];
+    int best = 0;
+    for (int i = 0; i < count; ++i) {
+        longest[i] = 1;
+        for (int j = 0; j < i; ++j) {
+            if (goals[j] < goals[i] && longest[j] + 1 > longest[i]) {
+                longest[i] = longest[j] + 1;
+            }
+        }
+        if (longest[i] > best) {
+            best = longest[i];
+        }
+    }
+    return count - best;
+}
+
+int rowConflicts(const unsigned char* cells, const int size, const int row) {
+    int goals[BOARD_MAX_SIZE];
+    int count = 0;
+    for (int col = 0; col < size; ++col) {
+        const int number = cells[row * size + col];
+        if (number != size * size && (number - 1) / size == row) {
+            goals[count++] = (number - 1) % size;
+        }
+    }
+    return lineConflicts(goals, count);
+}
+
+int colConflicts(const unsigned char* cells, const int size, const int col) {
+    int goals[BOARD_MAX_SIZE];
+    int count = 0;
+    for (int row = 0; row < size; ++row) {
+        const int number = cells[row * size + col];
+        if (number != size * size && (number - 1) % size == col) {
+            goals[count++] = (number - 1) / size;
+        }
+    }
+    return lineConflicts(goals, count);
+}
+
+int linearConflict(const unsigned char* cells, const int size) {
+    int conflicts = 0;
+    for (int line = 0; line < size; ++line) {
+        conflicts += rowConflicts(cells, size, line) + colConflicts(cells, size, line);
+    }
+    return 2 * conflicts;
+}
+
+template <int N>
+IncrementalEstimate<N>::IncrementalEstimate()
+    : mSize(N), mManhattan(0), mConflicts(0) {
+
+}
+
+template <int N>
+int IncrementalEstimate<N>::tileDistance(const int cell, const int number) const {
+    return BoardKernel<N>::TABLES.distance[cell][number];
+}
+
+template <>
+int IncrementalEstimate<0>::tileDistance(const int cell, const int number) const {
+    return abs(cell / mSize - (number - 1) / mSize) + abs(cell % mSize - (number - 1) % mSize);
+}
+
+template <int N>
+void IncrementalEstimate<N>::recountRow(const unsigned char* cells, const int row) {
+    const int conflicts = rowConflicts(cells, size(), row);
+    mConflicts += conflicts - mRowConflicts[row];
+    mRowConflicts[row] = conflicts;
+}
+
+template <int N>
+void IncrementalEstimate<N>::recountCol(const unsigned char* cells, const int col) {
+    const int conflicts = colConflicts(cells, size(), col);
+    mConflicts += conflicts - mColConflicts[col];
+    mColConflicts[col] = conflicts;
+}
+
+template <int N>
+void IncrementalEstimate<N>::reset(const unsigned char* cells, const int size) {
+    mSize = size;
+    mManhattan = manhattanGeneric(cells, size);
+    mConflicts = 0;
+    for (int line = 0; line < size; ++line) {
+        mRowConflicts[line] = rowConflicts(cells, size, line);
+        mColConflicts[line] = colConflicts(cells, size, line);
+        mConflicts += mRowConflicts[line] + mColConflicts[line];
+    }
+}
+
+template <int N>
+void IncrementalEstimate<N>::update(const unsigned char* cells, const int from, const int to) {
+    const int n = size();
+    const int number = cells[to];
+    mManhattan += tileDistance(to, number) - tileDistance(from, number);
+
+    // Only the lines across the move change: a horizontal move keeps the
+    // order within the row, so only the two columns are recounted, and vice
+    // versa. They are recounted rather than patched, since a conflict count
+    // has no O(1) update.
+    if (from / n == to / n) {
+        recountCol(cells, from % n);
+        recountCol(cells, to % n);
+    } else {
+        recountRow(cells, from / n);
+        recountRow(cells, to / n);
+    }
+}
+
+template <int N>
+int IncrementalEstimate<N>::get() const {
+    return mManhattan + 2 * mConflicts;
+}
+
+template <int N>
+bool IncrementalEstimate<N>::isSolved() const {
+    return mManhattan == 0;
+}
+
+template class IncrementalEstimate<0>;
+
+template <int N>
+class IdaSearch {
+    private:
+        unsigned char mCells[BOARD_MAX_CELLS];
+        int mBlank;
+        IncrementalEstimate<N> mEstimate;
+        int mBound;
+        unsigned long long mNodes;
+        unsigned long long mNodeLimit;
+        int* mPath;
+        int mPathCapacity;
+
+        int heuristic() const {
+            return mEstimate.get();
+        }
+
+        // Slides the tile at `cell` into the blank.
+        void slide(const int cell) {
+            const int to = mBlank;
+            mCells[to] = mCells[cell];
+            mCells[cell] = N * N;
+            mBlank = cell;
+            mEstimate.update(mCells, cell, to);
+        }
+
+        int search(const int depth, const int previous) {
+            const int estimate = depth + heuristic();
+            if (estimate > mBound) {
+                return estimate;
+            }
+            if (mEstimate.isSolved()) {
+                return FOUND;
+            }
+            if (depth >= mPathCapacity || (mNodeLimit != 0 && mNodes >= mNodeLimit)) {
+                return ABORTED;
+            }
+            ++mNodes;
+
+            int next = INT32_MAX;
+            const int count = BoardKernel<N>::TABLES.neighbourCount[mBlank];
+            for (int i = 0; i < count; ++i) {
+                const int cell = BoardKernel<N>::TABLES.neighbours[mBlank][i];
+                if (cell == previous) {
+                    continue;
+                }
+
+                const int from = mBlank;
+                slide(cell);
+                mPath[depth] = cell;
+                const int result = search(depth + 1, from);
+                slide(from);
+
+                if (result == FOUND || result == ABORTED) {
+                    return result;
+                }
+                if (result < next) {
+                    next = result;
+                }
+            }
+            return next;
+        }
+
+    public:
+        SolveResult solve(const unsigned char* cells, ScratchArena& arena, const unsigned long long nodeLimit) {
+            SolveResult result = {SOLVE_OUT_OF_MEMORY, 0, 0, nullptr};
+
+            memset(mCells, 0, sizeof(mCells));
+            memcpy(mCells, cells, N * N);
+            mEstimate.reset(mCells, N);
+            for (int i = 0; i < N * N; ++i) {
+                if (mCells[i] == N * N) {
+                    mBlank = i;
+                }
+            }
+
+            mNodes = 0;
+            mNodeLimit = nodeLimit;
+            mPathCapacity = 16 * N * N;
+            mPath = arena.allocate<int>(mPathCapacity);
+            if (mPath == nullptr) {
+                return result;
+            }
+
+            mBound = heuristic();
+            while (true) {
+                const int next = search(0, -1);
+                if (next == FOUND) {
+                    result.status = SOLVE_FOUND;
+                    result.length = mBound;
+                    result.moves = mPath;
+                    break;
+                }
+                if (next == ABORTED) {
+                    const bool limited = mNodeLimit != 0 && mNodes >= mNodeLimit;
+                    result.status = limited ? SOLVE_NODE_LIMIT : SOLVE_OUT_OF_MEMORY;
+                    break;
+                }
+                if (next == INT32_MAX) {
+                    result.status = SOLVE_UNSOLVABLE;
+                    break;
+                }
+                mBound = next;
+            }
+
+            result.nodes = mNodes;
+            return result;
+        }
+};
+
+template <int N>
+static SolveResult solveSized(const unsigned char* cells, ScratchArena& arena, const unsigned long long nodeLimit) {
+    void* memory = arena.allocate<IdaSearch<N>>(1);
+    if (memory == nullptr) {
+        return {SOLVE_OUT_OF_MEMORY, 0, 0, nullptr};
+    }
+    IdaSearch<N>* search = new (memory) IdaSearch<N>();
+    return search->solve(cells, arena, nodeLimit);
+}
+
+SolveResult solveOptimal(const unsigned char* cells, const int size, ScratchArena& arena, const unsigned long long nodeLimit) {
+    if (!isSolvable(cells, size)) {
+        return {SOLVE_UNSOLVABLE, 0, 0, nullptr};
+    }
+
+    switch (size) {
+        case 3:
+            return solveSized<3>(cells, arena, nodeLimit);
+        case 4:
+            return solveSized<4>(cells, arena, nodeLimit);
+        case 5:
+            return solveSized<5>(cells, arena, nodeLimit);
+        default:
+            return {SOLVE_UNSUPPORTED_SIZE, 0, 0, nullptr};
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include "boardKernels.h"
+#include "scratchArena.h"
+
+enum SolveStatus {
+    SOLVE_FOUND,
+    SOLVE_UNSOLVABLE,
+    SOLVE_UNSUPPORTED_SIZE,
+    SOLVE_NODE_LIMIT,
+    SOLVE_OUT_OF_MEMORY         // the arena or the path ran out of room
+};
+
+struct SolveResult {
+    SolveStatus status;
+    int length;
+    unsigned long long nodes;
+    // Cells the blank moves into, in order. Allocated from the arena passed
+    // to solveOptimal() and valid until it is reset.
+    int* moves;
+};
+
+bool isSolvable(const unsigned char* cells, const int size);
+int rowConflicts(const unsigned char* cells, const int size, const int row);
+int colConflicts(const unsigned char* cells, const int size, const int col);
+int linearConflict(const unsigned char* cells, const int size);
+
+// Manhattan distance plus linear conflicts, kept up to date one move at a
+// time. The Manhattan term changes in O(1). The conflicts are not updated in
+// O(1): the two lines the moved tile leaves and enters are recounted, which
+// is O(N^2) each with the longest increasing run behind lineConflicts(). The
+// other 2N - 2 lines are left alone.
+//
+// The optimal search instantiates it for its board size so the arithmetic
+// is specialised; N = 0 takes the size from reset(), which is what the
+// game's live readout uses as DistanceEstimate.
+template <int N>
+class IncrementalEstimate {
+    private:
+        int mSize;
+        int mManhattan;
+        int mRowConflicts[BOARD_MAX_SIZE];
+        int mColConflicts[BOARD_MAX_SIZE];
+        int mConflicts;
+
+        int size() const { return (N != 0) ? N : mSize; }
+        int tileDistance(const int cell, const int number) const;
+        void recountRow(const unsigned char* cells, const int row);
+        void recountCol(const unsigned char* cells, const int col);
+
+    public:
+        IncrementalEstimate();
+
+        void reset(const unsigned char* cells, const int size);
+        // Call after the tile at `from` has slid into the blank at `to`.
+        void update(const unsigned char* cells, const int from, const int to);
+        int get() const;
+        // Every tile is home exactly when the Manhattan term is zero.
+        bool isSolved() const;
+
+};
+
+typedef IncrementalEstimate<0> DistanceEstimate;
+
+// Optimal IDA* search with Manhattan distance plus linear conflicts for 3x3,
+// 4x4 and 5x5 boards. Gives up once nodeLimit nodes are expanded (0 means no
+// limit) or if the board is unsolvable or of another size; the status says
+// which.
+SolveResult solveOptimal(const unsigned char* cells, const int size, ScratchArena& arena, const unsigned long long nodeLimit);
@@ -0,0 +1,42 @@
+#pragma once
+#include <stddef.h>
+#include <atomic>
+
+// Lock-free ring buffer for exactly one producer thread and one consumer
+// thread. CAPACITY must be a power of two.
+template <typename T, size_t CAPACITY>
+class SpscQueue {
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+    private:
+        T mItems[CAPACITY];
+        alignas(64) std::atomic<size_t> mHead;
+        alignas(64) std::atomic<size_t> mTail;
+
+    public:
+        SpscQueue() : mHead(0), mTail(0) {}
+
+        SpscQueue(const SpscQueue&) = delete;
+        SpscQueue& operator=(const SpscQueue&) = delete;
+
+        bool push(const T& item) {
+            const size_t tail = mTail.load(std::memory_order_relaxed);
+            if (tail - mHead.load(std::memory_order_acquire) == CAPACITY) {
+                return false;
+            }
+            mItems[tail & (CAPACITY - 1)] = item;
+            mTail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool pop(T& item) {
+            const size_t head = mHead.load(std::memory_order_relaxed);
+            if (head == mTail.load(std::memory_order_acquire)) {
+                return false;
+            }
+            item = mItems[head & (CAPACITY - 1)];
+            mHead.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+};
@@ -1,47 +1,52 @@
 #include "startMenu.h"
 #include <SDL_mixer.h>
+#include "fontCache.h"
 
 StartMenu::StartMenu(SDL_Renderer* renderer, const unsigned int SCREEN_WIDTH, const unsigned int SCREEN_HEIGHT) 
-    : mSelectedButton(0), mMusicEnabled(true), mBGM(nullptr) {
+    : mButtons(3), mRenderer(renderer), mSelectedButton(0), mMusicEnabled(true), mBGM(nullptr) {
     
     mBGM = Mix_LoadMUS("assets/music.mp3");
     if (mBGM) {
         Mix_PlayMusic(mBGM, -1);
     }
 
-    const unsigned int BORDER_THICKNESS = 20;
-    const unsigned int BUTTON_WIDTH = SCREEN_WIDTH - 2 * BORDER_THICKNESS;
-    const unsigned int BUTTON_HEIGHT = 80;
-    const unsigned int BUTTON_SPACING = 20;
-
     const SDL_Color BUTTON_COLOUR = {255, 123, 43, 255};
     const SDL_Color SELECTED_COLOUR = {50, 255, 100, 255};
     const SDL_Color FONT_COLOUR = {0, 0, 0, 255};
 
-    TTF_Font* font = TTF_OpenFont("assets/ARCADECLASSIC.ttf", 40);
-    if (!font) {
-        std::cout << "Failed to load font! Error: " << TTF_GetError() << std::endl;
-        return;
+    for (int i = 0; i < 3; ++i) {
+        mButtons.emplace(SDL_Rect{0, 0, 0, 0}, BUTTON_COLOUR, 0, FONT_COLOUR);
     }
+    layout(SCREEN_WIDTH, SCREEN_HEIGHT);
 
     const char* buttonTexts[3] = {"PLAY GAME", "MUSIC: ON", "QUIT"};
+    for (int i = 0; i < 3; ++i) {
+        mButtons[i].loadTexture(renderer, buttonTexts[i]);
+    }
+
+    mButtons[0].changeColourTo(SELECTED_COLOUR);
+}
+
+// Proportions of the original 410x600 layout: 80 pixel buttons 20 apart,
+// 20 from the sides, with 40 point text.
+void StartMenu::layout(const unsigned int SCREEN_WIDTH, const unsigned int SCREEN_HEIGHT) {
+    const unsigned int BORDER_THICKNESS = SCREEN_WIDTH / 20;
+    const unsigned int BUTTON_WIDTH = SCREEN_WIDTH - 2 * BORDER_THICKNESS;
+    const unsigned int BUTTON_HEIGHT = SCREEN_HEIGHT * 2 / 15;
+    const unsigned int BUTTON_SPACING = SCREEN_HEIGHT / 30;
+    const int fontSize = quantizeFontSize(BUTTON_HEIGHT / 2);
+
     int startY = (SCREEN_HEIGHT - (3 * BUTTON_HEIGHT + 2 * BUTTON_SPACING)) / 2;
 
     for (int i = 0; i < 3; ++i) {
         SDL_Rect rect = {
-            BORDER_THICKNESS,
-            startY + i * (BUTTON_HEIGHT + BUTTON_SPACING),
-            BUTTON_WIDTH,
-            BUTTON_HEIGHT
+            (int)BORDER_THICKNESS,
+            (int)(startY + i * (BUTTON_HEIGHT + BUTTON_SPACING)),
+            (int)BUTTON_WIDTH,
+            (int)BUTTON_HEIGHT
         };
-        Button button(rect, BUTTON_COLOUR, font, FONT_COLOUR);
-        button.loadTexture(renderer, buttonTexts[i]);
-        mButtons.push_back(button);
+        mButtons[i].setLayout(mRenderer, rect, fontSize);
     }
-
-    mButtons[0].changeColourTo(SELECTED_COLOUR);
-
-    TTF_CloseFont(font);
 }
 
 StartMenu::~StartMenu() {
@@ -49,10 +54,6 @@ StartMenu::~StartMenu() {
         Mix_FreeMusic(mBGM);
         mBGM = nullptr;
     }
-
-    for (auto& button : mButtons) {
-        button.free();
-    }
 }
 
 int StartMenu::handleInput(SDL_Event& event) {
@@ -96,9 +97,9 @@ void StartMenu::toggleMusic() {
     mMusicEnabled = !mMusicEnabled;
     if (mMusicEnabled) {
         Mix_ResumeMusic();
-        mButtons[1].loadTexture(nullptr, "MUSIC: ON");
+        mButtons[1].loadTexture(mRenderer, "MUSIC: ON");
     } else {
         Mix_PauseMusic();
-        mButtons[1].loadTexture(nullptr, "MUSIC: OFF");
+        mButtons[1].loadTexture(mRenderer, "MUSIC: OFF");
     }
 } 
\ No newline at end of file
@@ -2,12 +2,13 @@
 #include <SDL.h>
 #include <SDL_ttf.h>
 #include <SDL_mixer.h>
-#include <vector>
 #include "button.h"
+#include "pool.h"
 
 class StartMenu {
 private:
-    std::vector<Button> mButtons;
+    Pool<Button> mButtons;
+    SDL_Renderer* mRenderer;
     int mSelectedButton;
     bool mMusicEnabled;
     Mix_Music* mBGM;
@@ -16,6 +17,7 @@ public:
     StartMenu(SDL_Renderer* renderer, const unsigned int SCREEN_WIDTH, const unsigned int SCREEN_HEIGHT);
     ~StartMenu();
 
+    void layout(const unsigned int SCREEN_WIDTH, const unsigned int SCREEN_HEIGHT);
     int handleInput(SDL_Event& event);
     void render(SDL_Renderer* renderer);
     bool isMusicEnabled() const { return mMusicEnabled; }
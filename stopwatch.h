@@ -7,18 +7,12 @@
 
 class Stopwatch : public UserInterface {
     private:
-        time_t mStartTime;
         char mElapsedTime[80];
-        bool mIsPaused;
-        time_t mPauseTime;
-        time_t mTotalPausedTime;
+        time_t mShownTime;
 
     public:
-        Stopwatch(const SDL_Rect& rect, const SDL_Color& colour, TTF_Font* const font, const SDL_Color& fontColour);
+        Stopwatch(const SDL_Rect& rect, const SDL_Color& colour, const int fontSize, const SDL_Color& fontColour);
 
-        void start();
-        void calculateTime(SDL_Renderer* const renderer);
-        void pause();
-        void resume();
+        void showTime(SDL_Renderer* const renderer, const time_t elapsedTime);
         
 };
\ No newline at end of file
@@ -0,0 +1,302 @@
+#include "stressTest.h"
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#ifdef __linux__
+#include <unistd.h>
+#endif
+#include "boardKernels.h"
+#include "button.h"
+#include "fontCache.h"
+#include "logger.h"
+#include "pool.h"
+#include "puzzleBoard.h"
+#include "textureCache.h"
+#include "tile.h"
+
+static const double TICK_MS = 1000.0 / 120;
+static const unsigned int MAX_TICKS_PER_FRAME = 8;
+static const float MOVE_TICKS = 12;
+static const unsigned int SCRAMBLE_SWAPS = 200;
+
+// Every UserInterface::render is a fill plus a copy of its text.
+static const unsigned int DRAW_CALLS_PER_ELEMENT = 2;
+
+static const unsigned int SWEEP_BOARDS[] = {1, 4, 16, 64};
+static const unsigned int SWEEP_SIZES[] = {3, 4, 5, 8};
+
+static const unsigned int MAX_BOARDS = 1024;
+
+// Frame times come from the display; these are what it does not measure.
+struct StressStats {
+    unsigned long long frames;
+    double totalUpdateMs;
+    double totalRenderMs;
+    unsigned long long ticks;
+    unsigned long long drawCalls;
+};
+
+void setDefaultStressOptions(StressOptions& options) {
+    options = {false, false, 64, 8, 3};
+}
+
+bool parseStressOption(int argc, char* args[], int& i, StressOptions& options) {
+    if (strcmp(args[i], "--stress") == 0 && i + 2 < argc) {
+        options.enabled = true;
+        options.boards = atoi(args[++i]);
+        options.size = atoi(args[++i]);
+        return options.boards > 0 && options.boards <= MAX_BOARDS && options.size >= 2 && options.size <= BOARD_MAX_SIZE;
+    } else if (strcmp(args[i], "--stress-sweep") == 0) {
+        options.enabled = true;
+        options.sweep = true;
+    } else if (strcmp(args[i], "--stress-seconds") == 0 && i + 1 < argc) {
+        options.seconds = atoi(args[++i]);
+        return options.seconds > 0;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void printStressUsage() {
+    fprintf(stderr,
+        "  --stress K N        run K boards of NxN with random moves instead of the game\n"
+        "                      (K at most 1024)\n"
+        "  --stress-sweep      measure a range of board counts and sizes, then exit\n"
+        "  --stress-seconds S  seconds per report, or per configuration when\n"
+        "                      sweeping (default 3)\n");
+}
+
+static size_t residentMemory() {
+#ifdef __linux__
+    FILE* file = fopen("/proc/self/statm", "r");
+    if (file == nullptr) {
+        return 0;
+    }
+    unsigned long pages = 0;
+    unsigned long resident = 0;
+    const bool read = fscanf(file, "%lu %lu", &pages, &resident) == 2;
+    fclose(file);
+    return read ? resident * sysconf(_SC_PAGESIZE) : 0;
+#else
+    return 0;
+#endif
+}
+
+static void printHeader() {
+    printf("boards\tsize\ttiles\tfps\tframe_ms\tframe_sd_ms\tworst_ms\tupdate_ms\trender_ms\tticks\tdraws\tboard_kb\ttextures\ttexture_kb\trss_kb\n");
+}
+
+static void printRow(const unsigned int boards, const unsigned int size, const StressStats& stats, const FrameStats& frameStats) {
+    if (stats.frames == 0 || frameStats.frames == 0) {
+        return;
+    }
+    const double frames = stats.frames;
+    const double meanFrameMs = frameStats.meanFrameMs;
+    const double deviation = sqrt(frameStats.frameM2 / frameStats.frames);
+    const size_t tiles = boards * size * size;
+    const size_t boardBytes = boards * (sizeof(PuzzleBoard) + sizeof(TileGrid)) + tiles * sizeof(Tile);
+
+    printf("%u\t%u\t%zu\t%.1f\t%.3f\t%.3f\t%.3f\t%.3f\t%.3f\t%.1f\t%.0f\t%zu\t%zu\t%zu\t%zu\n",
+        boards, size, tiles,
+        1000.0 / meanFrameMs, meanFrameMs, deviation, frameStats.worstFrameMs,
+        stats.totalUpdateMs / frames, stats.totalRenderMs / frames, stats.ticks / frames,
+        stats.drawCalls / frames,
+        boardBytes / 1024, gTextureCache.size(), gTextureCache.memoryUsage() / 1024, residentMemory() / 1024);
+    fflush(stdout);
+}
+
+static double millisecondsSince(const Uint64 start) {
+    return (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+// Runs one configuration for reportSeconds, or indefinitely with a row every
+// reportSeconds when repeat is set. Returns false once the user closed it.
+static bool runConfiguration(Display& display, const unsigned int boardCount, const unsigned int size, const unsigned int reportSeconds, const bool repeat) {
+    SDL_Renderer* renderer = display.getRenderer();
+    const BoardOps ops = getBoardOps(size);
+
+    const unsigned int COLUMNS = ceil(sqrt((double)boardCount));
+    const unsigned int ROWS = (boardCount + COLUMNS - 1) / COLUMNS;
+
+    const SDL_Color TILE_COLOUR = {0, 191, 255, 255};
+    const SDL_Color FONT_COLOUR = {0, 0, 0, 255};
+    const SDL_Color HEADER_COLOUR = {255, 255, 102, 255};
+
+    const SDL_Rect NO_RECT = {0, 0, 0, 0};
+    Button header(NO_RECT, HEADER_COLOUR, 0, FONT_COLOUR);
+    header.setTransientText(true);
+    Pool<PuzzleBoard> boards(boardCount);
+    std::vector<std::unique_ptr<TileGrid>> grids;
+    std::vector<SDL_Point> slots(boardCount * size * size);
+    std::vector<int> previousBlank(boardCount, -1);
+    for (unsigned int i = 0; i < boardCount; ++i) {
+        PuzzleBoard& board = boards.emplace(ops, MOVE_TICKS, MOVE_TICKS);
+        board.scramble(i + 1, SCRAMBLE_SWAPS);
+
+        grids.emplace_back(new TileGrid(size));
+        for (unsigned int cell = 0; cell < size * size; ++cell) {
+            grids[i]->emplace(NO_RECT, TILE_COLOUR, 0, FONT_COLOUR, cell + 1);
+        }
+    }
+
+    auto layout = [&]() {
+        // Signed throughout: with many boards in a small window the spacing
+        // alone can exceed the window, and the boards shrink to a pixel.
+        const int SCREEN_WIDTH = display.getWidth();
+        const int SCREEN_HEIGHT = display.getHeight();
+        const int HEADER_HEIGHT = SCREEN_HEIGHT / 15;
+        const int BOARD_SPACING = 4;
+        const int BORDER_THICKNESS = 1;
+        const int BOARD_WIDTH = std::max(1, (SCREEN_WIDTH - (int)(COLUMNS + 1) * BOARD_SPACING) / (int)COLUMNS);
+        const int BOARD_HEIGHT = std::max(1, (SCREEN_HEIGHT - HEADER_HEIGHT - (int)(ROWS + 1) * BOARD_SPACING) / (int)ROWS);
+        const int BOARD_PIXELS = std::min(BOARD_WIDTH, BOARD_HEIGHT);
+        const int TILE_PIXELS = std::max(1, (BOARD_PIXELS - (int)(size + 1) * BORDER_THICKNESS) / (int)size);
+        const int tileFontSize = quantizeFontSize(TILE_PIXELS * 3 / 5);
+
+        header.setLayout(renderer, {BOARD_SPACING, BOARD_SPACING, SCREEN_WIDTH - 2 * BOARD_SPACING, HEADER_HEIGHT - BOARD_SPACING}, quantizeFontSize(HEADER_HEIGHT / 2));
+
+        for (unsigned int i = 0; i < boardCount; ++i) {
+            const int boardX = BOARD_SPACING + (int)(i % COLUMNS) * (BOARD_WIDTH + BOARD_SPACING);
+            const int boardY = HEADER_HEIGHT + BOARD_SPACING + (int)(i / COLUMNS) * (BOARD_HEIGHT + BOARD_SPACING);
+            for (unsigned int cell = 0; cell < size * size; ++cell) {
+                const int x = boardX + BORDER_THICKNESS + (int)(cell % size) * (TILE_PIXELS + BORDER_THICKNESS);
+                const int y = boardY + BORDER_THICKNESS + (int)(cell / size) * (TILE_PIXELS + BORDER_THICKNESS);
+                slots[i * size * size + cell] = {x, y};
+                (*grids[i])[cell / size][cell % size].setLayout(renderer, {x, y, TILE_PIXELS, TILE_PIXELS}, tileFontSize);
+            }
+        }
+    };
+    layout();
+
+    char caption[64];
+    snprintf(caption, sizeof(caption), "%u boards %ux%u", boardCount, size, size);
+    header.loadTexture(renderer, caption);
+    for (unsigned int i = 0; i < boardCount; ++i) {
+        for (unsigned int cell = 0; cell < size * size; ++cell) {
+            (*grids[i])[cell / size][cell % size].loadTexture(renderer, std::to_string(cell + 1).c_str());
+        }
+    }
+
+    StressStats stats = {};
+    bool open = true;
+    bool stop = false;
+    bool layoutChanged = false;
+    double accumulator = 0;
+    Uint64 lastFrame = SDL_GetPerformanceCounter();
+    Uint64 reportStart = lastFrame;
+    display.resetStats();
+    SDL_Event event;
+
+    while (!stop) {
+        while (SDL_PollEvent(&event) != 0) {
+            if (event.type == SDL_QUIT || (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_ESCAPE)) {
+                stop = true;
+                open = false;
+            }
+            if (display.handleEvent(event)) {
+                layoutChanged = true;
+            }
+        }
+
+        if (layoutChanged) {
+            layout();
+            layoutChanged = false;
+        }
+
+        const Uint64 frameStart = SDL_GetPerformanceCounter();
+        accumulator += (frameStart - lastFrame) * 1000.0 / SDL_GetPerformanceFrequency();
+        lastFrame = frameStart;
+
+        unsigned int ticks = 0;
+        while (accumulator >= TICK_MS && ticks < MAX_TICKS_PER_FRAME) {
+            for (unsigned int i = 0; i < boardCount; ++i) {
+                PuzzleBoard& board = boards[i];
+                if (!board.isMoving()) {
+                    int moves[4];
+                    const int count = ops.generateMoves(board.getEmptyIndex(), moves, size);
+                    int choice = rand() % count;
+                    if (moves[choice] == previousBlank[i]) {
+                        choice = (choice + 1) % count;
+                    }
+                    previousBlank[i] = board.getEmptyIndex();
+                    board.startMove(moves[choice]);
+                }
+                board.tick();
+            }
+            accumulator -= TICK_MS;
+            ++ticks;
+        }
+        if (ticks == MAX_TICKS_PER_FRAME) {
+            accumulator = 0;
+        }
+        stats.ticks += ticks;
+        stats.totalUpdateMs += millisecondsSince(frameStart);
+
+        if (display.beginFrame()) {
+            const Uint64 renderStart = SDL_GetPerformanceCounter();
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+            SDL_RenderClear(renderer);
+
+            header.render(renderer);
+            unsigned long long drawCalls = 1 + DRAW_CALLS_PER_ELEMENT;
+
+            for (unsigned int i = 0; i < boardCount; ++i) {
+                const PuzzleBoard& board = boards[i];
+                TileGrid& grid = *grids[i];
+                grid.place(board.getCells(), board.getEmptyIndex(), board.getMovingIndex(), board.getProgress(), &slots[i * size * size]);
+                for (unsigned int number = 1; number < size * size; ++number) {
+                    grid[(number - 1) / size][(number - 1) % size].render(renderer);
+                }
+                drawCalls += (size * size - 1) * DRAW_CALLS_PER_ELEMENT;
+            }
+            stats.totalRenderMs += millisecondsSince(renderStart);
+            stats.drawCalls += drawCalls;
+            stats.frames++;
+
+            display.present();
+        }
+
+        if (millisecondsSince(reportStart) >= reportSeconds * 1000.0) {
+            const FrameStats& frameStats = display.getStats();
+            printRow(boardCount, size, stats, frameStats);
+            if (repeat && frameStats.frames != 0) {
+                snprintf(caption, sizeof(caption), "%u boards %ux%u %.0f fps", boardCount, size, size, 1000.0 / frameStats.meanFrameMs);
+                header.loadTexture(renderer, caption);
+            }
+            if (repeat) {
+                stats = {};
+                display.resetStats();
+                reportStart = SDL_GetPerformanceCounter();
+            } else {
+                stop = true;
+            }
+        }
+    }
+
+    return open;
+}
+
+void runStressTest(Display& display, const StressOptions& options) {
+    printHeader();
+
+    if (!options.sweep) {
+        runConfiguration(display, options.boards, options.size, options.seconds, true);
+        return;
+    }
+
+    for (const unsigned int size : SWEEP_SIZES) {
+        for (const unsigned int boards : SWEEP_BOARDS) {
+            if (!runConfiguration(display, boards, size, options.seconds, false)) {
+                return;
+            }
+        }
+    }
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include "display.h"
+
+struct StressOptions {
+    bool enabled;
+    bool sweep;
+    unsigned int boards;
+    unsigned int size;
+    unsigned int seconds;       // per report, or per configuration when sweeping
+};
+
+void setDefaultStressOptions(StressOptions& options);
+// Consumes args[i], and its values, when it is a stress test option.
+bool parseStressOption(int argc, char* args[], int& i, StressOptions& options);
+void printStressUsage();
+
+// Plays random moves on many independent boards at once, laid out in a grid
+// and drawn with the game's own tiles, and prints frame time, update and
+// render cost, draw calls and memory as tab-separated rows on stdout. A
+// single configuration reports every few seconds until the window is closed;
+// a sweep runs a range of board counts and sizes and reports each once.
+void runStressTest(Display& display, const StressOptions& options);
@@ -0,0 +1,139 @@
+#include "textureCache.h"
+#include <stdio.h>
+#include "fontCache.h"
+#include "logger.h"
+
+TextureCache gTextureCache;
+
+TextureHandle::TextureHandle()
+    : mEntry(nullptr) {
+
+}
+
+TextureHandle::TextureHandle(CachedTexture* entry)
+    : mEntry(entry) {
+
+}
+
+TextureHandle::TextureHandle(TextureHandle&& other) noexcept
+    : mEntry(other.mEntry) {
+    other.mEntry = nullptr;
+}
+
+TextureHandle& TextureHandle::operator=(TextureHandle&& other) noexcept {
+    if (this != &other) {
+        reset();
+        mEntry = other.mEntry;
+        other.mEntry = nullptr;
+    }
+    return *this;
+}
+
+TextureHandle::~TextureHandle() {
+    reset();
+}
+
+SDL_Texture* TextureHandle::get() const {
+    return (mEntry != nullptr) ? mEntry->texture : nullptr;
+}
+
+int TextureHandle::getWidth() const {
+    return (mEntry != nullptr) ? mEntry->width : 0;
+}
+
+int TextureHandle::getHeight() const {
+    return (mEntry != nullptr) ? mEntry->height : 0;
+}
+
+void TextureHandle::reset() {
+    if (mEntry != nullptr) {
+        gTextureCache.release(mEntry);
+        mEntry = nullptr;
+    }
+}
+
+TextureHandle TextureCache::acquire(SDL_Renderer* const renderer, const int fontSize, const SDL_Color& colour, const char* text, const bool transient) {
+    // The font cache opens one font per size, so the size identifies it.
+    char prefix[32];
+    snprintf(prefix, sizeof(prefix), "%d:%02x%02x%02x%02x:", fontSize, colour.r, colour.g, colour.b, colour.a);
+    std::string key = std::string(prefix) + text;
+
+    auto found = mEntries.find(key);
+    if (found != mEntries.end()) {
+        CachedTexture& entry = found->second;
+        if (entry.refCount++ == 0) {
+            mIdle.erase(entry.idle);
+        }
+        entry.keepIdle = entry.keepIdle || !transient;
+        return TextureHandle(&entry);
+    }
+
+    TTF_Font* font = gFontCache.get(fontSize);
+    if (font == nullptr) {
+        return TextureHandle();
+    }
+
+    SDL_Surface* textSurface = TTF_RenderText_Solid(font, text, colour);
+    if (textSurface == nullptr) {
+        LOG_ERROR("Unable to render text surface! Error: %s", TTF_GetError());
+        return TextureHandle();
+    }
+
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, textSurface);
+    const int width = textSurface->w;
+    const int height = textSurface->h;
+    SDL_FreeSurface(textSurface);
+
+    if (texture == nullptr) {
+        LOG_ERROR("Unable to create texture form rendered text! Error: %s", SDL_GetError());
+        return TextureHandle();
+    }
+
+    CachedTexture& entry = mEntries[key];
+    entry = {key, texture, width, height, 1, !transient, mIdle.end()};
+    return TextureHandle(&entry);
+}
+
+void TextureCache::release(CachedTexture* entry) {
+    if (--entry->refCount == 0) {
+        if (!entry->keepIdle) {
+            destroy(entry);
+            return;
+        }
+        mIdle.push_front(entry);
+        entry->idle = mIdle.begin();
+        if (mIdle.size() > IDLE_CAPACITY) {
+            CachedTexture* oldest = mIdle.back();
+            mIdle.pop_back();
+            destroy(oldest);
+        }
+    }
+}
+
+void TextureCache::destroy(CachedTexture* entry) {
+    SDL_DestroyTexture(entry->texture);
+    mEntries.erase(mEntries.find(entry->key));
+}
+
+void TextureCache::clear() {
+    for (CachedTexture* entry : mIdle) {
+        destroy(entry);
+    }
+    mIdle.clear();
+}
+
+size_t TextureCache::size() const {
+    return mEntries.size();
+}
+
+size_t TextureCache::idleCount() const {
+    return mIdle.size();
+}
+
+size_t TextureCache::memoryUsage() const {
+    size_t bytes = 0;
+    for (const auto& entry : mEntries) {
+        bytes += (size_t)entry.second.width * entry.second.height * 4;
+    }
+    return bytes;
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+struct CachedTexture {
+    std::string key;
+    SDL_Texture* texture;
+    int width;
+    int height;
+    unsigned int refCount;
+    bool keepIdle;              // false while only ever acquired as transient text
+    std::list<CachedTexture*>::iterator idle;   // position in the idle list while unreferenced
+};
+
+// Move-only reference to a cached texture. The texture is destroyed when the
+// last handle referring to it goes away.
+class TextureHandle {
+    private:
+        CachedTexture* mEntry;
+
+    public:
+        TextureHandle();
+        explicit TextureHandle(CachedTexture* entry);
+        TextureHandle(TextureHandle&& other) noexcept;
+        TextureHandle& operator=(TextureHandle&& other) noexcept;
+        TextureHandle(const TextureHandle&) = delete;
+        TextureHandle& operator=(const TextureHandle&) = delete;
+        ~TextureHandle();
+
+        SDL_Texture* get() const;
+        int getWidth() const;
+        int getHeight() const;
+        void reset();
+
+};
+
+// Text textures keyed by font size, colour and text, so identical labels
+// share a single texture. They all belong to the display's renderer, and
+// Display::close() clears the cache before destroying it. A texture nobody
+// references any more is kept on an LRU list, so a label going back to a
+// size it was drawn at before (a window resized back and forth) finds its
+// texture still there; only the least recently used IDLE_CAPACITY of them
+// are kept. Text that changes all the time, like the stopwatch, is acquired
+// as transient and destroyed as soon as it is released.
+class TextureCache {
+    private:
+        static const size_t IDLE_CAPACITY = 512;
+
+        std::unordered_map<std::string, CachedTexture> mEntries;
+        std::list<CachedTexture*> mIdle;
+
+        void destroy(CachedTexture* entry);
+
+    public:
+        TextureCache() = default;
+        TextureCache(const TextureCache&) = delete;
+        TextureCache& operator=(const TextureCache&) = delete;
+
+        TextureHandle acquire(SDL_Renderer* const renderer, const int fontSize, const SDL_Color& colour, const char* text, const bool transient = false);
+        void release(CachedTexture* entry);
+        // Destroys every texture not referenced by a handle.
+        void clear();
+        size_t size() const;
+        size_t idleCount() const;
+        // Approximate texture memory held, at four bytes per texel.
+        size_t memoryUsage() const;
+
+};
+
+extern TextureCache gTextureCache;
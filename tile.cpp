@@ -1,7 +1,7 @@
 #include "tile.h"
 
-Tile::Tile(const SDL_Rect& rect, const SDL_Color& colour, TTF_Font* const font, const SDL_Color& fontColour, const int number) 
-    : Button(rect, colour, font, fontColour),
+Tile::Tile(const SDL_Rect& rect, const SDL_Color& colour, const int fontSize, const SDL_Color& fontColour, const int number) 
+    : Button(rect, colour, fontSize, fontColour),
       mNumber(number) {
     
 }
@@ -42,3 +42,16 @@ void Tile::setPositionTo(const int x, const int y) {
 int Tile::getNumber() {
     return mNumber;
 }
+
+void TileGrid::place(const unsigned char* cells, const int emptyIndex, const int movingIndex, const float progress, const SDL_Point* slots) {
+    const int size = mSize;
+    for (int cell = 0; cell < size * size; ++cell) {
+        int x = slots[cell].x;
+        int y = slots[cell].y;
+        if (cell == movingIndex) {
+            x += (slots[emptyIndex].x - x) * progress;
+            y += (slots[emptyIndex].y - y) * progress;
+        }
+        mTiles[cells[cell] - 1].setPositionTo(x, y);
+    }
+}
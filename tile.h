@@ -2,13 +2,14 @@
 #include <SDL.h>
 #include <SDL_ttf.h>
 #include "button.h"
+#include "pool.h"
 
 class Tile: public Button {
     private:
         int mNumber;
         
     public:
-        Tile(const SDL_Rect& rect, const SDL_Color& colour, TTF_Font* const font, const SDL_Color& mFontColour, const int number);
+        Tile(const SDL_Rect& rect, const SDL_Color& colour, const int fontSize, const SDL_Color& mFontColour, const int number);
 
         int getXPosition();
         int getYPosition();
@@ -17,3 +18,25 @@ class Tile: public Button {
         int getNumber();
         
 };
+
+// Square board of tiles stored row by row in one pool; tiles[row][col]
+// addresses a tile in place.
+class TileGrid {
+    private:
+        Pool<Tile> mTiles;
+        unsigned int mSize;
+
+    public:
+        explicit TileGrid(const unsigned int size) : mTiles(size * size), mSize(size) {}
+
+        template <typename... Args>
+        Tile& emplace(Args&&... args) { return mTiles.emplace(std::forward<Args>(args)...); }
+
+        Tile* operator[](const unsigned int row) { return &mTiles[row * mSize]; }
+        unsigned int size() const { return mSize; }
+
+        // Puts every tile at the slot of the cell holding its number, with
+        // the tile at movingIndex progress of the way towards the blank.
+        void place(const unsigned char* cells, const int emptyIndex, const int movingIndex, const float progress, const SDL_Point* slots);
+
+};
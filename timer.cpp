@@ -0,0 +1,54 @@
+#include "timer.h"
+
+Timer::Timer()
+    : mStartTime(0), mIsPaused(false), mPauseTime(0), mTotalPausedTime(0) {
+
+}
+
+void Timer::start() {
+    time(&mStartTime);
+    mIsPaused = false;
+    mTotalPausedTime = 0;
+}
+
+void Timer::pause() {
+    if (!mIsPaused) {
+        time(&mPauseTime);
+        mIsPaused = true;
+    }
+}
+
+void Timer::resume() {
+    if (mIsPaused) {
+        time_t currentTime;
+        time(&currentTime);
+        mTotalPausedTime += currentTime - mPauseTime;
+        mIsPaused = false;
+    }
+}
+
+bool Timer::isPaused() const {
+    return mIsPaused;
+}
+
+time_t Timer::getElapsedTime() const {
+    time_t currentTime;
+    if (mIsPaused) {
+        currentTime = mPauseTime;
+    } else {
+        time(&currentTime);
+    }
+    return currentTime - mStartTime - mTotalPausedTime;
+}
+
+time_t Timer::getTotalPausedTime() const {
+    return mTotalPausedTime;
+}
+
+void Timer::restore(const time_t elapsedTime, const time_t totalPausedTime) {
+    time_t currentTime;
+    time(&currentTime);
+    mStartTime = currentTime - elapsedTime - totalPausedTime;
+    mTotalPausedTime = totalPausedTime;
+    mIsPaused = false;
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <time.h>
+
+// Wall-clock game timer with pause support, free of any rendering so it can
+// run on the simulation thread.
+class Timer {
+    private:
+        time_t mStartTime;
+        bool mIsPaused;
+        time_t mPauseTime;
+        time_t mTotalPausedTime;
+
+    public:
+        Timer();
+
+        void start();
+        void pause();
+        void resume();
+        bool isPaused() const;
+
+        time_t getElapsedTime() const;
+        time_t getTotalPausedTime() const;
+        void restore(const time_t elapsedTime, const time_t totalPausedTime);
+
+};
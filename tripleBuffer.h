@@ -0,0 +1,42 @@
+#pragma once
+#include <atomic>
+
+// Lock-free handoff of whole values from one writer thread to one reader
+// thread. The writer fills its private buffer and publishes it; the reader
+// picks up the newest published buffer, so neither side ever waits and
+// stale frames are simply skipped.
+template <typename T>
+class TripleBuffer {
+    private:
+        static const unsigned int FRESH = 4;
+        static const unsigned int INDEX_MASK = 3;
+
+        T mBuffers[3];
+        std::atomic<unsigned int> mShared;
+        unsigned int mWriteIndex;
+        unsigned int mReadIndex;
+
+    public:
+        TripleBuffer() : mShared(1), mWriteIndex(0), mReadIndex(2) {}
+
+        TripleBuffer(const TripleBuffer&) = delete;
+        TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+        T& writeBuffer() { return mBuffers[mWriteIndex]; }
+
+        void publish() {
+            mWriteIndex = mShared.exchange(mWriteIndex | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+        }
+
+        // Returns true if a newer value was picked up.
+        bool update() {
+            if ((mShared.load(std::memory_order_relaxed) & FRESH) == 0) {
+                return false;
+            }
+            mReadIndex = mShared.exchange(mReadIndex, std::memory_order_acq_rel) & INDEX_MASK;
+            return true;
+        }
+
+        const T& readBuffer() const { return mBuffers[mReadIndex]; }
+
+};
@@ -1,31 +1,39 @@
 #include "userInterface.h"
+#include "logger.h"
 
-UserInterface::UserInterface(const SDL_Rect& rect, const SDL_Color& colour, TTF_Font* const font, const SDL_Color& fontColour) 
+UserInterface::UserInterface(const SDL_Rect& rect, const SDL_Color& colour, const int fontSize, const SDL_Color& fontColour) 
     : mRect(rect), mColour(colour), 
-      mFontRect({0, 0, 0, 0}), mFontColour(fontColour), mFont(font), 
-      mTexture(nullptr) {
+      mFontRect({0, 0, 0, 0}), mFontColour(fontColour), mFontSize(fontSize), 
+      mTexture(), mTransientText(false) {
     
 }
 
 void UserInterface::loadTexture(SDL_Renderer* const renderer, const char* text) {
-    free(); 
+    mText = text;
+    mTexture = gTextureCache.acquire(renderer, mFontSize, mFontColour, text, mTransientText);
+    if (mTexture.get() != nullptr) {
+        mFontRect.w = mTexture.getWidth();
+        mFontRect.h = mTexture.getHeight();
+    }
+    centerText();
+}
 
-    SDL_Surface* textSurface = TTF_RenderText_Solid(mFont, text, mFontColour);
-    if (textSurface == nullptr) {
-        std::cout << "Unable to render text surface! Error: " << TTF_GetError() << std::endl; 
-    } else {
-        mTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-        if (mTexture == nullptr) {
-            std::cout << "Unable to create texture form rendered text! Error: " << SDL_GetError() << std::endl;
-        } else {
-            mFontRect.w = textSurface->w;
-            mFontRect.h = textSurface->h;
+void UserInterface::setLayout(SDL_Renderer* const renderer, const SDL_Rect& rect, const int fontSize) {
+    mRect = rect;
+    if (fontSize != mFontSize) {
+        mFontSize = fontSize;
+        if (!mText.empty()) {
+            loadTexture(renderer, mText.c_str());
+            return;
         }
-        SDL_FreeSurface(textSurface);
     }
     centerText();
 }
 
+void UserInterface::setTransientText(const bool transient) {
+    mTransientText = transient;
+}
+
 void UserInterface::centerText() {
     mFontRect.y = mRect.y + 0.5 * (mRect.h - mFontRect.h);
 	mFontRect.x = mRect.x + 0.5 * (mRect.w - mFontRect.w);
@@ -35,16 +43,9 @@ void UserInterface::render(SDL_Renderer* const renderer) const {
     SDL_SetRenderDrawColor(renderer, mColour.r, mColour.g, mColour.b, mColour.a);
     SDL_RenderFillRect(renderer, &mRect);
 
-    if (mTexture != nullptr) {
-        SDL_RenderCopy(renderer, mTexture, nullptr, &mFontRect);
+    if (mTexture.get() != nullptr) {
+        SDL_RenderCopy(renderer, mTexture.get(), nullptr, &mFontRect);
     } else {
-        std::cout << "Warning: no texture to render!" << std::endl;
+        LOG_WARNING("No texture to render!");
     }
 }
-
-void UserInterface::free() {
-    if (mTexture != nullptr) {
-        SDL_DestroyTexture(mTexture);
-        mTexture = nullptr;
-    }
-}
\ No newline at end of file
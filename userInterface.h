@@ -2,24 +2,33 @@
 #include <SDL.h>
 #include <SDL_ttf.h>
 #include <iostream>
+#include <string>
+#include "textureCache.h"
 
 class UserInterface {
     protected:
         SDL_Rect mRect;
         SDL_Color mColour;
 
-        TTF_Font* mFont;
+        int mFontSize;
         SDL_Rect mFontRect;
         SDL_Color mFontColour;
-        SDL_Texture* mTexture;
+        TextureHandle mTexture;
+        std::string mText;
+        bool mTransientText;    // text that is unlikely to be shown again
 
         void centerText();
 
     public:
-        UserInterface(const SDL_Rect& rect, const SDL_Color& colour, TTF_Font* const font, const SDL_Color& fontColour);
+        UserInterface(const SDL_Rect& rect, const SDL_Color& colour, const int fontSize, const SDL_Color& fontColour);
 
         void loadTexture(SDL_Renderer* const renderer, const char* text);
+        // Moves and resizes the element; the text is rasterized again only
+        // if the font size changed.
+        void setLayout(SDL_Renderer* const renderer, const SDL_Rect& rect, const int fontSize);
         void render(SDL_Renderer* const renderer) const;
-        void free();
+        // Text that keeps changing is dropped from the texture cache as soon
+        // as it is replaced instead of being kept for reuse.
+        void setTransientText(const bool transient);
 
 };
\ No newline at end of file